@@ -0,0 +1,118 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+
+/****************************************************
+*													*
+*	BoundedQueue.h Blocking queue with a fixed		*
+*	capacity between two dump stages. The producer	*
+*	waits if the consumer falls behind, so a fast	*
+*	stage never buffers the whole dump.				*
+*													*
+****************************************************/
+
+/**
+ * \brief Multi producer multi consumer queue with a capacity. Once closed, push fails and pop drains the rest.
+ * \tparam T item type
+ */
+template <typename T>
+class BoundedQueue
+{
+	std::deque<T> items{};
+	size_t capacity;
+	bool closed = false;
+	std::mutex mutex;
+	std::condition_variable notFull;
+	std::condition_variable notEmpty;
+
+public:
+
+	explicit BoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+	BoundedQueue(const BoundedQueue&) = delete;
+	BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+	/**
+	 * \brief adds the item, waits while the queue is full
+	 * \param item the item
+	 * \return false if the queue got closed, the item is dropped then
+	 */
+	bool push(T item)
+	{
+		std::unique_lock lock(mutex);
+		notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+		if (closed)
+			return false;
+		items.push_back(std::move(item));
+		lock.unlock();
+		notEmpty.notify_one();
+		return true;
+	}
+
+	/**
+	 * \brief adds the item if there is room, never waits
+	 * \param item the item, only moved out on success
+	 * \return false if the queue is full or closed
+	 */
+	bool tryPush(T& item)
+	{
+		std::unique_lock lock(mutex);
+		if (closed || items.size() >= capacity)
+			return false;
+		items.push_back(std::move(item));
+		lock.unlock();
+		notEmpty.notify_one();
+		return true;
+	}
+
+	/**
+	 * \brief takes the next item, waits until there is one
+	 * \param item the item
+	 * \return false if the queue is closed and empty
+	 */
+	bool pop(T& item)
+	{
+		std::unique_lock lock(mutex);
+		notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+		if (items.empty())
+			return false;
+		item = std::move(items.front());
+		items.pop_front();
+		lock.unlock();
+		notFull.notify_one();
+		return true;
+	}
+
+	/**
+	 * \brief no more items get added. Wakes up everyone who waits, the consumers still get the remaining items.
+	 * The consumer can close the queue as well if it stops early, the producer then doesnt block anymore.
+	 */
+	void close()
+	{
+		{
+			std::lock_guard lock(mutex);
+			closed = true;
+		}
+		notFull.notify_all();
+		notEmpty.notify_all();
+	}
+
+	bool isClosed()
+	{
+		std::lock_guard lock(mutex);
+		return closed;
+	}
+
+	/**
+	 * \brief opens the queue again and drops the remaining items. Only call it when nobody uses the queue, e.g. before a retry
+	 */
+	void reset()
+	{
+		std::lock_guard lock(mutex);
+		items.clear();
+		closed = false;
+	}
+};
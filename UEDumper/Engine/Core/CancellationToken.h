@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+
+
+/****************************************************
+*													*
+*	CancellationToken.h Cooperative cancellation.	*
+*	Nothing gets killed, the long loops check the	*
+*	token and return early once it got cancelled.	*
+*													*
+****************************************************/
+
+/**
+ * \brief Flag that gets set once and is checked by the ones that should stop. Reset it before the job starts again.
+ */
+class CancellationToken
+{
+	std::atomic<bool> bCancelled = false;
+
+public:
+
+	void cancel() { bCancelled = true; }
+
+	void reset() { bCancelled = false; }
+
+	bool isCancelled() const { return bCancelled; }
+};
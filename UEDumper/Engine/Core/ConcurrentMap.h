@@ -0,0 +1,253 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <functional>
+
+
+/****************************************************
+*													*
+*	ConcurrentMap.h Insert only hash map that is	*
+*	safe for concurrent readers and writers. It is	*
+*	used for the core caches that get touched by	*
+*	the dump thread, LiveMemory and the UI thread.	*
+*													*
+****************************************************/
+
+//number of shards every map has. Writers only lock their shard, so this limits how many writers can run in parallel
+#define CONCURRENTMAP_SHARD_CT 64
+
+/**
+ * \brief Insert only hash map. Reads of already published entries are lock free, writers lock one shard.
+ * Entries never move once inserted, so pointers returned by find/insert stay valid until clear() gets called.
+ * Values are not protected by the map, if you modify a value after inserting it, you have to sync that yourself.
+ * \tparam K key type
+ * \tparam V value type
+ * \tparam Hash hash of the key
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class ConcurrentMap
+{
+	struct Entry
+	{
+		K key;
+		V value;
+	};
+
+	//chain link in a bucket. Links are never modified once published so readers can walk them without locks
+	struct Link
+	{
+		Entry* entry;
+		Link* next;
+	};
+
+	struct Table
+	{
+		size_t mask = 0;
+		std::atomic<Link*>* buckets = nullptr;
+		//all links of this table, freed together with the table
+		std::deque<Link> links{};
+	};
+
+	struct Shard
+	{
+		std::atomic<Table*> table = nullptr;
+		std::atomic<size_t> count = 0;
+		//only writers take this
+		std::mutex writeMutex;
+		//entries in insertion order, deque keeps their addresses stable
+		std::deque<Entry> entries{};
+		//tables replaced by a resize. Readers might still walk them, so they are only freed in clear()
+		std::vector<Table*> retired{};
+	};
+
+	Shard shards[CONCURRENTMAP_SHARD_CT];
+
+	static size_t mix(size_t h)
+	{
+		//splitmix64 finalizer, std::hash is identity for integers
+		h ^= h >> 30;
+		h *= 0xBF58476D1CE4E5B9ull;
+		h ^= h >> 27;
+		h *= 0x94D049BB133111EBull;
+		h ^= h >> 31;
+		return h;
+	}
+
+	static Table* createTable(size_t bucketCount)
+	{
+		auto table = new Table();
+		table->mask = bucketCount - 1;
+		table->buckets = new std::atomic<Link*>[bucketCount];
+		for (size_t i = 0; i < bucketCount; i++)
+			table->buckets[i].store(nullptr, std::memory_order_relaxed);
+		return table;
+	}
+
+	static void deleteTable(Table* table)
+	{
+		if (!table)
+			return;
+		delete[] table->buckets;
+		delete table;
+	}
+
+	Shard& getShard(size_t hash)
+	{
+		return shards[hash >> 58 & (CONCURRENTMAP_SHARD_CT - 1)];
+	}
+
+	const Shard& getShard(size_t hash) const
+	{
+		return shards[hash >> 58 & (CONCURRENTMAP_SHARD_CT - 1)];
+	}
+
+	static Entry* findInTable(const Table* table, size_t hash, const K& key)
+	{
+		if (!table)
+			return nullptr;
+		for (Link* link = table->buckets[hash & table->mask].load(std::memory_order_acquire); link; link = link->next)
+		{
+			if (link->entry->key == key)
+				return link->entry;
+		}
+		return nullptr;
+	}
+
+	//writer lock of the shard must be held
+	static void linkEntry(Table* table, size_t hash, Entry* entry)
+	{
+		auto& bucket = table->buckets[hash & table->mask];
+		Link& link = table->links.emplace_back(Link{ entry, bucket.load(std::memory_order_relaxed) });
+		bucket.store(&link, std::memory_order_release);
+	}
+
+	//writer lock of the shard must be held
+	static void grow(Shard& shard)
+	{
+		Table* oldTable = shard.table.load(std::memory_order_relaxed);
+		Table* newTable = createTable(oldTable ? (oldTable->mask + 1) * 2 : 16);
+		for (auto& entry : shard.entries)
+			linkEntry(newTable, mix(Hash{}(entry.key)), &entry);
+		//publish the new table, readers still walking the old one find everything that was in there
+		shard.table.store(newTable, std::memory_order_release);
+		if (oldTable)
+			shard.retired.push_back(oldTable);
+	}
+
+public:
+
+	ConcurrentMap() = default;
+	ConcurrentMap(const ConcurrentMap&) = delete;
+	ConcurrentMap& operator=(const ConcurrentMap&) = delete;
+
+	~ConcurrentMap()
+	{
+		clear();
+	}
+
+	/**
+	 * \brief lock free lookup
+	 * \param key the key
+	 * \return pointer to the value or nullptr if the key is not in the map
+	 */
+	V* find(const K& key)
+	{
+		const size_t hash = mix(Hash{}(key));
+		Entry* entry = findInTable(getShard(hash).table.load(std::memory_order_acquire), hash, key);
+		return entry ? &entry->value : nullptr;
+	}
+
+	const V* find(const K& key) const
+	{
+		const size_t hash = mix(Hash{}(key));
+		const Entry* entry = findInTable(getShard(hash).table.load(std::memory_order_acquire), hash, key);
+		return entry ? &entry->value : nullptr;
+	}
+
+	bool contains(const K& key) const
+	{
+		return find(key) != nullptr;
+	}
+
+	/**
+	 * \brief inserts the value if the key is not in the map yet
+	 * \param key the key
+	 * \param value the value
+	 * \return pointer to the value in the map (the already existing one if the key was inserted before)
+	 */
+	V* insert(const K& key, V value)
+	{
+		const size_t hash = mix(Hash{}(key));
+		Shard& shard = getShard(hash);
+
+		std::lock_guard lock(shard.writeMutex);
+
+		Table* table = shard.table.load(std::memory_order_relaxed);
+		if (Entry* existing = findInTable(table, hash, key))
+			return &existing->value;
+
+		Entry& entry = shard.entries.emplace_back(Entry{ key, std::move(value) });
+
+		//keep the load factor below 2
+		if (!table || shard.entries.size() > (table->mask + 1) * 2)
+			grow(shard);
+		else
+			linkEntry(table, hash, &entry);
+
+		shard.count.fetch_add(1, std::memory_order_relaxed);
+		return &entry.value;
+	}
+
+	V* insert(const std::pair<K, V>& pair)
+	{
+		return insert(pair.first, pair.second);
+	}
+
+	size_t size() const
+	{
+		size_t total = 0;
+		for (const auto& shard : shards)
+			total += shard.count.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	/**
+	 * \brief calls the function for every entry. Entries that get inserted while iterating may or may not be visited.
+	 * Locks one shard at a time, so dont insert into the same map inside the function.
+	 * \param func function taking the key and the value
+	 */
+	void forEach(const std::function<void(const K&, V&)>& func)
+	{
+		for (auto& shard : shards)
+		{
+			std::lock_guard lock(shard.writeMutex);
+			for (auto& entry : shard.entries)
+				func(entry.key, entry.value);
+		}
+	}
+
+	/**
+	 * \brief removes all entries. NOT safe while other threads read the map, all returned pointers get invalid.
+	 */
+	void clear()
+	{
+		for (auto& shard : shards)
+		{
+			std::lock_guard lock(shard.writeMutex);
+			deleteTable(shard.table.exchange(nullptr));
+			for (const auto table : shard.retired)
+				deleteTable(table);
+			shard.retired.clear();
+			shard.entries.clear();
+			shard.count.store(0, std::memory_order_relaxed);
+		}
+	}
+};
@@ -1,7 +1,11 @@
 #include "Core.h"
 
+#include <charconv>
+
 #include "FName_decryption.h"
+#include "ThreadPool.h"
 #include "../UEClasses/UnrealClasses.h"
+#include "../Userdefined/PackageFilter.h"
 #include "../Userdefined/StructDefinitions.h"
 #include "Frontend/Windows/LogWindow.h"
 #include "Frontend/Windows/PackageViewerWindow.h"
@@ -14,6 +18,12 @@
 //https://github.com/EpicGames/UnrealEngine/blob/5.1/Engine/Source/Runtime/Core/Private/UObject/UnrealNames.cpp#L3375
 //https://github.com/EpicGames/UnrealEngine/blob/release/Engine/Source/Runtime/Core/Private/UObject/UnrealNames.cpp#L251
 
+//bytes of a block of the name pool (>= 4.23), a block holds 0x10000 entry offsets of the stride FNameToString uses
+#if WITH_CASE_PRESERVING_NAME
+constexpr uint32_t namePoolBlockSize = 4 * 0x10000;
+#else
+constexpr uint32_t namePoolBlockSize = 2 * 0x10000;
+#endif
 
 //flag some invalid characters in a name
 std::string generateValidVarName(const std::string& str)
@@ -32,14 +42,30 @@ std::string generateValidVarName(const std::string& str)
 	return result;
 };
 
-//we always compare this function to FName::ToString(FString& Out) in the source code
 std::string EngineCore::FNameToString(FName fname)
 {
-	if (FNameCache.contains(fname.ComparisonIndex))
+	return std::string(FNameToStringView(fname));
+}
+
+std::string_view EngineCore::FNameToStringView(FName fname)
+{
+	if (const auto cachedName = FNameCache.find(fname.ComparisonIndex); cachedName.data())
 	{
-		return FNameCache[fname.ComparisonIndex];
+		return cachedName;
 	}
 
+	const auto cachedName = FNameCache.insert(fname.ComparisonIndex, readFNameFromMemory(fname));
+
+	if (cachedName.empty())
+		return "null";
+	//throw std::runtime_error("empty name is trying to get cached");
+
+	return cachedName;
+}
+
+//we always compare this function to FName::ToString(FString& Out) in the source code
+std::string EngineCore::readFNameFromMemory(FName fname)
+{
 	//unreal engine 4.19 - 4.22 fname read function
 #if UE_VERSION < UE_4_23
 
@@ -175,16 +201,342 @@ std::string EngineCore::FNameToString(FName fname)
 	fname_decrypt(name, nameLength);
 #endif
 
+	return std::string(name);
+}
+
+//turns a wide name from the name table into our ansi string, FNameToString doesnt support anything else anyways
+static std::string wideNameToString(const uint16_t* wideName, size_t length)
+{
+	std::string result(length, '_');
+	for (size_t i = 0; i < length; i++)
+	{
+		if (wideName[i] < 0x80)
+			result[i] = static_cast<char>(wideName[i]);
+	}
+	return result;
+}
 
-	std::string finalName = std::string(name);
+//a name that got parsed from a bulk read of the name table, it points into the read buffer
+struct ParsedFName
+{
+	int index = 0;
+	char* name = nullptr;
+	//length in characters
+	int length = 0;
+	bool bIsWide = false;
+};
 
-	if (finalName.empty())
-		finalName = "null";
-	//throw std::runtime_error("empty name is trying to get cached");
+//decrypts the names with one call of the batch decryption
+static void decryptParsedFNames(ParsedFName* names, size_t count, bool bIncludeWide)
+{
+#if USE_FNAME_ENCRYPTION
+	std::vector<char*> buffers;
+	std::vector<int> lengths;
+	buffers.reserve(count);
+	lengths.reserve(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		if (!names[i].name || (names[i].bIsWide && !bIncludeWide))
+			continue;
+		buffers.push_back(names[i].name);
+		lengths.push_back(names[i].length);
+	}
+	fname_decrypt_batch(buffers.data(), lengths.data(), static_cast<int>(buffers.size()));
+#endif
+}
+
+int64_t EngineCore::bulkCacheFNames(int64_t& finishedNames, int64_t& totalNames)
+{
+	int64_t cachedNames = 0;
+	finishedNames = 0;
+
+	//merges the decoded names into the cache, always on this thread and in order
+	auto mergeNames = [&](const ParsedFName* names, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				const auto& parsed = names[i];
+				if (!parsed.name || parsed.length <= 0)
+					continue;
+				if (parsed.bIsWide)
+					FNameCache.insert(parsed.index, wideNameToString(reinterpret_cast<const uint16_t*>(parsed.name), parsed.length));
+				else
+					FNameCache.insert(parsed.index, std::string_view(parsed.name, parsed.length));
+				cachedNames++;
+			}
+		};
+
+#if UE_VERSION < UE_4_23
+
+#if WITH_CASE_PRESERVING_NAME
+	//the cache uses the ComparisonIndex but the name is read from the DisplayIndex, we cant map that from the table.
+	//FNameToString reads them one by one
+	totalNames = 0;
+	return 0;
+#else
+	//see FNameToString for how the TNameEntryArray works
+	constexpr auto ElementsPerChunk = 0x4000;
+	//more chunks than any game uses (MaxTotalElements / ElementsPerChunk)
+	constexpr auto MaxChunks = 0x200;
+	//bytes we read of every entry in the first pass. Longer names get read again
+	constexpr auto EntryReadSize = 0x60;
+	enum { NAME_SIZE = 1024 };
+
+#if UE_VERSION == UE_4_22
+	constexpr uint64_t nameOffset = 0xC;
+#else
+	constexpr uint64_t nameOffset = 0x10;
+#endif
+	constexpr size_t maxLength = EntryReadSize - (nameOffset - 8);
+
+	std::vector<uint64_t> chunks(MaxChunks);
+	Memory::read(reinterpret_cast<void*>(gNames + GNAMES_POOL_OFFSET), chunks.data(), MaxChunks * sizeof(uint64_t));
+	size_t numChunks = 0;
+	while (numChunks < MaxChunks && chunks[numChunks])
+		numChunks++;
+	totalNames = numChunks;
+
+	std::vector<uint64_t> entryPtrs(ElementsPerChunk);
+	std::vector<char> entries(static_cast<size_t>(ElementsPerChunk) * EntryReadSize);
+	std::vector<Memory::ScatterEntry> reads;
+	std::vector<int32_t> readIndexes;
+	std::vector<ParsedFName> parsedNames;
+	//names that didnt fit into the first read
+	std::vector<std::string> longNames;
+	for (; finishedNames < static_cast<int64_t>(numChunks); finishedNames++)
+	{
+		if (ObjectsManager::CRITICAL_STOP_CALLED())
+			return cachedNames;
+
+		//a chunk is just the array of FNameEntry pointers
+		Memory::read(reinterpret_cast<void*>(chunks[finishedNames]), entryPtrs.data(), ElementsPerChunk * sizeof(uint64_t));
+
+		reads.clear();
+		readIndexes.clear();
+		for (int32_t i = 0; i < ElementsPerChunk; i++)
+		{
+			if (!entryPtrs[i])
+				continue;
+			//read from the Index field on, its lowest bit tells if the name is wide
+			reads.push_back({ reinterpret_cast<void*>(entryPtrs[i] + 8), entries.data() + reads.size() * EntryReadSize, EntryReadSize });
+			readIndexes.push_back(i);
+		}
+		Memory::readScatter(reads);
+
+		parsedNames.assign(reads.size(), {});
+		longNames.assign(reads.size(), {});
+
+		//every thread parses and decrypts its own slice
+		ThreadPool::parallelFor(reads.size(), 1024, [&](size_t start, size_t end)
+			{
+				for (size_t i = start; i < end; i++)
+				{
+					char* entry = static_cast<char*>(reads[i].buffer);
+					auto& parsed = parsedNames[i];
+					parsed.index = static_cast<int>(finishedNames * ElementsPerChunk + readIndexes[i]);
+					parsed.bIsWide = *reinterpret_cast<int32_t*>(entry) & 1;
+					parsed.name = entry + (nameOffset - 8);
+
+					size_t length = 0;
+					if (parsed.bIsWide)
+					{
+						while (length < maxLength / 2 && reinterpret_cast<uint16_t*>(parsed.name)[length])
+							length++;
+						if (length == maxLength / 2)
+						{
+							longNames[i].assign(NAME_SIZE + 2, 0);
+							parsed.name = longNames[i].data();
+							Memory::read(reinterpret_cast<void*>(entryPtrs[readIndexes[i]] + nameOffset), parsed.name, NAME_SIZE);
+							length = 0;
+							while (length < NAME_SIZE / 2 && reinterpret_cast<uint16_t*>(parsed.name)[length])
+								length++;
+						}
+					}
+					else
+					{
+						length = strnlen(parsed.name, maxLength);
+						if (length == maxLength)
+						{
+							longNames[i].assign(NAME_SIZE + 2, 0);
+							parsed.name = longNames[i].data();
+							Memory::read(reinterpret_cast<void*>(entryPtrs[readIndexes[i]] + nameOffset), parsed.name, NAME_SIZE);
+							length = strnlen(parsed.name, NAME_SIZE);
+						}
+					}
+					parsed.length = static_cast<int>(length);
+				}
+				//wide names never got decrypted in this engine version
+				decryptParsedFNames(parsedNames.data() + start, end - start, false);
+			});
+
+		mergeNames(parsedNames.data(), parsedNames.size());
+	}
+#endif
+
+#else // >= 4_23
+
+	//FNameEntryAllocator, see
+	//https://github.com/EpicGames/UnrealEngine/blob/5.1/Engine/Source/Runtime/Core/Private/UObject/UnrealNames.cpp#L224
+	struct FNameEntryAllocatorHeader
+	{
+		uint64_t Lock;
+		uint32_t CurrentBlock;
+		uint32_t CurrentByteCursor;
+	};
+	constexpr uint32_t FNameMaxBlocks = 8192;
+	//read this many blocks together so we dont need the whole pool in memory at once
+	constexpr uint32_t BlocksPerRead = 16;
+
+	//the entries are aligned to the same stride FNameToString multiplies the offset with
+#if WITH_CASE_PRESERVING_NAME
+	constexpr uint32_t Stride = 4;
+	//the ComparisonId comes before the header
+	constexpr uint32_t HeaderOffset = 4;
+#else
+	constexpr uint32_t Stride = 2;
+	constexpr uint32_t HeaderOffset = 0;
+#endif
+	constexpr uint32_t BlockSize = Stride * 0x10000;
+	constexpr uint32_t EntryHeaderSize = HeaderOffset + sizeof(uint16_t);
+	//same limit as readFNameFromMemory
+	enum { NAME_SIZE = 1024 };
+
+	const auto allocator = Memory::read<FNameEntryAllocatorHeader>(gNames);
+	if (allocator.CurrentBlock >= FNameMaxBlocks || allocator.CurrentByteCursor > BlockSize)
+	{
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "ENGINECORE", "Name pool header looks invalid (block %d, cursor 0x%X), reading FNames one by one!", allocator.CurrentBlock, allocator.CurrentByteCursor);
+		totalNames = 0;
+		return 0;
+	}
+
+	const uint32_t numBlocks = allocator.CurrentBlock + 1;
+	totalNames = numBlocks;
+
+	std::vector<uint64_t> blocks(numBlocks);
+	Memory::read(reinterpret_cast<void*>(gNames + 8 * 2), blocks.data(), numBlocks * sizeof(uint64_t));
+
+	//numbered entries point to another entry, we resolve them once all plain names are cached
+	struct NumberedEntry
+	{
+		int index;
+		uint32_t id;
+		uint32_t number;
+	};
+
+	//everything a thread parsed out of one block
+	struct ParsedBlock
+	{
+		std::vector<ParsedFName> names;
+		std::vector<NumberedEntry> numberedEntries;
+	};
+
+	std::vector<uint8_t> buffer(static_cast<size_t>(BlocksPerRead) * BlockSize);
+	std::vector<Memory::ScatterEntry> reads;
+	std::vector<ParsedBlock> parsedBlocks(BlocksPerRead);
+	std::vector<NumberedEntry> numberedEntries;
+	for (uint32_t firstBlock = 0; firstBlock < numBlocks; firstBlock += BlocksPerRead)
+	{
+		if (ObjectsManager::CRITICAL_STOP_CALLED())
+			return cachedNames;
+
+		const uint32_t blockCount = numBlocks - firstBlock < BlocksPerRead ? numBlocks - firstBlock : BlocksPerRead;
+
+		reads.clear();
+		for (uint32_t i = 0; i < blockCount; i++)
+		{
+			const uint32_t block = firstBlock + i;
+			//the current block is only filled up to the cursor
+			const uint32_t blockBytes = block == allocator.CurrentBlock ? allocator.CurrentByteCursor : BlockSize;
+			if (blocks[block] && blockBytes)
+				reads.push_back({ reinterpret_cast<void*>(blocks[block]), buffer.data() + static_cast<size_t>(i) * BlockSize, blockBytes });
+		}
+		Memory::readScatter(reads);
+
+		//every block gets parsed and decrypted by its own thread
+		ThreadPool::parallelFor(reads.size(), 1, [&](size_t start, size_t end)
+			{
+				for (size_t readIndex = start; readIndex < end; readIndex++)
+				{
+					const auto& read = reads[readIndex];
+					auto& parsedBlock = parsedBlocks[readIndex];
+					parsedBlock.names.clear();
+					parsedBlock.numberedEntries.clear();
+
+					const uint32_t block = firstBlock + static_cast<uint32_t>((static_cast<uint8_t*>(read.buffer) - buffer.data()) / BlockSize);
+					uint8_t* data = static_cast<uint8_t*>(read.buffer);
+					const auto limit = static_cast<uint32_t>(read.size);
+
+					uint32_t offset = 0;
+					while (offset + EntryHeaderSize <= limit)
+					{
+						uint8_t* entry = data + offset;
+						const uint16_t header = *reinterpret_cast<const uint16_t*>(entry + HeaderOffset);
+						const bool bIsWide = header & 1;
+#if WITH_CASE_PRESERVING_NAME
+						//FNameEntryHeader: bIsWide : 1, Len : 15
+						const uint16_t length = header >> 1;
+#else
+						//FNameEntryHeader: bIsWide : 1, LowercaseProbeHash : 5, Len : 10
+						const uint16_t length = header >> 6;
+#endif
+						uint8_t* nameData = entry + EntryHeaderSize;
+						const int index = static_cast<int>(block << 16 | offset / Stride);
+
+						if (length == 0)
+						{
+#if UE_VERSION > UE_5_00 && UE_FNAME_OUTLINE_NUMBER
+							//FNumberedData: the id of the name and the number
+							if (offset + EntryHeaderSize + 8 <= limit)
+							{
+								const uint32_t id = *reinterpret_cast<const uint32_t*>(nameData);
+								const uint32_t number = *reinterpret_cast<const uint32_t*>(nameData + 4);
+								if (id)
+								{
+									parsedBlock.numberedEntries.push_back({ index, id, number });
+									offset += (EntryHeaderSize + 8 + Stride - 1) & ~(Stride - 1);
+									continue;
+								}
+							}
+#endif
+							//UE terminates full blocks with a empty header
+							break;
+						}
+
+						const uint32_t byteLength = bIsWide ? length * 2u : length;
+						if (offset + EntryHeaderSize + byteLength > limit)
+							break;
 
-	FNameCache.insert(std::pair(fname.ComparisonIndex, std::string(name)));
+						//the next entry comes after the full name, only the copy is clamped like in readFNameFromMemory
+						parsedBlock.names.push_back({ index, reinterpret_cast<char*>(nameData), length < NAME_SIZE ? length : NAME_SIZE, bIsWide });
 
-	return finalName;
+						offset += (EntryHeaderSize + byteLength + Stride - 1) & ~(Stride - 1);
+					}
+
+					decryptParsedFNames(parsedBlock.names.data(), parsedBlock.names.size(), true);
+				}
+			});
+
+		for (size_t i = 0; i < reads.size(); i++)
+		{
+			mergeNames(parsedBlocks[i].names.data(), parsedBlocks[i].names.size());
+			numberedEntries.insert(numberedEntries.end(), parsedBlocks[i].numberedEntries.begin(), parsedBlocks[i].numberedEntries.end());
+		}
+		finishedNames += blockCount;
+	}
+
+	for (const auto& numbered : numberedEntries)
+	{
+		const auto baseName = FNameCache.find(static_cast<int>(numbered.id));
+		if (!baseName.data())
+			continue;
+		//the number is stored internally +1, see NAME_INTERNAL_TO_EXTERNAL
+		FNameCache.insert(numbered.index, std::string(baseName) + "_" + std::to_string(static_cast<int>(numbered.number) - 1));
+		cachedNames++;
+	}
+
+#endif
+
+	return cachedNames;
 }
 
 uint64_t EngineCore::getOffsetAddress(const Offset& offset)
@@ -218,40 +570,354 @@ std::vector<Offset> EngineCore::getOffsets()
 	return offsets;
 }
 
-bool EngineCore::generateFNameFile(int& progressDone, int& totalProgress)
+uint64_t EngineCore::getTargetFingerprint()
 {
-	//the master header contains all the imports sorted
-	std::ofstream FNameFile(EngineSettings::getWorkingDirectory() / "FNames.txt");
+	//FNV-1a over everything that changes with a new build of the game or a different dumper setup
+	uint64_t hash = 0xCBF29CE484222325;
+	auto addToHash = [&hash](const void* data, size_t size)
+		{
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= static_cast<const uint8_t*>(data)[i];
+				hash *= 0x100000001B3;
+			}
+		};
 
-	totalProgress = FNameCache.size();
+	const uint64_t base = Memory::getBaseAddress();
+	const auto dosHeader = Memory::read<IMAGE_DOS_HEADER>(base);
+	if (dosHeader.e_magic != IMAGE_DOS_SIGNATURE)
+		return 0;
+	const auto ntHeaders = Memory::read<IMAGE_NT_HEADERS>(base + dosHeader.e_lfanew);
+	if (ntHeaders.Signature != IMAGE_NT_SIGNATURE)
+		return 0;
+
+	addToHash(&ntHeaders.FileHeader.TimeDateStamp, sizeof(ntHeaders.FileHeader.TimeDateStamp));
+	addToHash(&ntHeaders.FileHeader.NumberOfSections, sizeof(ntHeaders.FileHeader.NumberOfSections));
+	addToHash(&ntHeaders.OptionalHeader.SizeOfImage, sizeof(ntHeaders.OptionalHeader.SizeOfImage));
+	addToHash(&ntHeaders.OptionalHeader.CheckSum, sizeof(ntHeaders.OptionalHeader.CheckSum));
+
+	const int settings[] = { UE_VERSION, WITH_CASE_PRESERVING_NAME, USE_FNAME_ENCRYPTION };
+	addToHash(settings, sizeof(settings));
+	const uint64_t gNamesOffset = gNames - base;
+	addToHash(&gNamesOffset, sizeof(gNamesOffset));
+
+	return hash;
+}
+
+bool EngineCore::readNamePoolState(uint32_t& block, uint32_t& cursor)
+{
+#if UE_VERSION < UE_4_23
+	return false;
+#else
+	//FNameEntryAllocator, like in bulkCacheFNames
+	struct FNameEntryAllocatorHeader
+	{
+		uint64_t Lock;
+		uint32_t CurrentBlock;
+		uint32_t CurrentByteCursor;
+	};
+	const auto allocator = Memory::read<FNameEntryAllocatorHeader>(gNames);
+	if (allocator.CurrentBlock >= 8192 || allocator.CurrentByteCursor > namePoolBlockSize)
+		return false;
+
+	block = allocator.CurrentBlock;
+	cursor = allocator.CurrentByteCursor;
+	return true;
+#endif
+}
+
+uint64_t EngineCore::hashFirstNameBlock(uint32_t bytes)
+{
+	if (bytes > namePoolBlockSize)
+		bytes = namePoolBlockSize;
+
+	std::vector<uint8_t> buffer(bytes);
+	const auto firstBlock = Memory::read<uint64_t>(gNames + 8 * 2);
+	if (firstBlock && bytes)
+		Memory::read(reinterpret_cast<void*>(firstBlock), buffer.data(), bytes);
+
+	Fingerprint hash;
+	hash.add(buffer.data(), buffer.size());
+	return hash.get();
+}
+
+bool EngineCore::saveFNameCacheFile()
+{
+	const uint64_t fingerprint = getTargetFingerprint();
+	if (!fingerprint)
+		return false;
+
+	//the pool state before we look at the cache, every cached name is older than that
+	uint32_t poolBlock = 0;
+	uint32_t poolCursor = 0;
+	const bool bHasPool = readNamePoolState(poolBlock, poolCursor);
 
-	std::vector<std::pair<int, std::string>> sortedNames;
+	std::vector<FNameFileEntry> entries;
+	entries.reserve(FNameCache.size());
+	std::string blob;
+	FNameCache.forEach([&](int index, std::string_view name)
+		{
+			entries.push_back({ index, static_cast<uint32_t>(blob.size()), static_cast<uint32_t>(name.size()) });
+			blob.append(name);
+		});
+
+	FNameFileHeader header;
+	header.fingerprint = fingerprint;
+	header.count = static_cast<uint32_t>(entries.size());
+	header.blobSize = blob.size();
+	if (bHasPool)
+	{
+		header.poolBlock = poolBlock;
+		header.poolCursor = poolCursor;
+		//the first block is full once there is a second one
+		header.firstBlockBytes = poolBlock > 0 ? namePoolBlockSize : poolCursor;
+		header.firstBlockHash = hashFirstNameBlock(header.firstBlockBytes);
+	}
+
+	std::ofstream file(EngineSettings::getWorkingDirectory() / "FNames.bin", std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "ENGINECORE", "Could not create FNames.bin!");
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(FNameFileEntry)));
+	file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+	return file.good();
+}
+
+std::filesystem::path EngineCore::getCheckpointPath(const std::string& name)
+{
+	const auto directory = EngineSettings::getWorkingDirectory() / "Checkpoints";
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+	return directory / name;
+}
+
+uint64_t EngineCore::getPackagesCheckpointKey()
+{
+	const uint64_t fingerprint = getTargetFingerprint();
+	if (!fingerprint || !ObjectsManager::objectSnapshotId)
+		return 0;
+
+	Fingerprint key;
+	key.add(static_cast<int64_t>(fingerprint));
+	key.add(static_cast<int64_t>(ObjectsManager::objectSnapshotId));
+	key.add(static_cast<int64_t>(PACKAGE_FILTER_PULL_DEPENDENCIES));
+	for (const auto patterns : { &includedPackages, &excludedPackages })
+	{
+		key.add(static_cast<int64_t>(patterns->size()));
+		for (const auto& pattern : *patterns)
+			key.add(std::string_view(pattern));
+	}
+
+	//the userdefined structs and enums of StructDefinitions.h get copied into the packages, so their content is part of the key.
+	//The maps have no fixed order, they get hashed sorted by their name
+	for (const auto structs : { &overridingStructs, &overridingStructMembers })
+	{
+		std::vector<std::pair<std::string_view, const EngineStructs::Struct*>> sorted;
+		sorted.reserve(structs->size());
+		for (const auto& [name, struc] : *structs)
+			sorted.push_back(std::pair(std::string_view(name), &struc));
+		std::ranges::sort(sorted, {}, &std::pair<std::string_view, const EngineStructs::Struct*>::first);
+		key.add(static_cast<int64_t>(sorted.size()));
+		for (const auto& [name, struc] : sorted)
+			struc->addToFingerprint(key);
+	}
+	key.add(static_cast<int64_t>(customStructs.size()));
+	for (const auto& struc : customStructs)
+		struc.addToFingerprint(key);
+	key.add(static_cast<int64_t>(customEnums.size()));
+	for (const auto& enu : customEnums)
+		enu.addToFingerprint(key);
+
+	//settings that change what gets generated, the ones of the game build are in the target fingerprint already
+	const int64_t settings[] = { DUMPER_VERSION, USE_LAZY_MEMBERS, FUOBJECTITEM_SIZE, UE_BLUEPRINT_EVENTGRAPH_FASTCALLS };
+	for (const int64_t setting : settings)
+		key.add(setting);
+#if UE_VERSION >= UE_4_25
+	key.add(static_cast<int64_t>(WITH_EDITORONLY_DATA));
+#endif
+#if UE_VERSION >= UE_5_00
+	key.add(static_cast<int64_t>(WITH_LIVE_CODING));
+#endif
+	key.add(static_cast<int64_t>(PACKAGES_CHECKPOINT_VERSION));
+	return key.get();
+}
+
+bool EngineCore::savePackagesCheckpoint()
+{
+	const uint64_t key = getPackagesCheckpointKey();
+	if (!key)
+		return false;
 
-	for (const auto& pair : FNameCache)
+	nlohmann::json checkpoint;
+	checkpoint["key"] = key;
+	nlohmann::json jPackages = nlohmann::json::array();
+	for (const auto& package : packages)
+		jPackages.push_back(package.toJson());
+	checkpoint["Packages"] = jPackages;
+	checkpoint["UnknownProperties"] = unknownProperties;
+
+	std::ofstream file(getCheckpointPath("Packages.json"), std::ios::trunc);
+	if (!file)
 	{
-		sortedNames.emplace_back(pair);
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "ENGINECORE", "Could not create Packages.json!");
+		return false;
 	}
+	file << checkpoint.dump();
+	return file.good();
+}
+
+bool EngineCore::loadPackagesCheckpoint()
+{
+	const uint64_t key = getPackagesCheckpointKey();
+	if (!key)
+		return false;
+
+	std::ifstream file(getCheckpointPath("Packages.json"));
+	if (!file)
+		return false;
+	const nlohmann::json checkpoint = nlohmann::json::parse(file, nullptr, false);
+	if (checkpoint.is_discarded() || !checkpoint.contains("key") || checkpoint["key"] != key ||
+		!checkpoint.contains("Packages") || !checkpoint.contains("UnknownProperties"))
+		return false;
+
+	for (const nlohmann::json& package : checkpoint["Packages"])
+		packages.push_back(EngineStructs::Package::fromJson(package));
+	unknownProperties = checkpoint["UnknownProperties"];
+	return true;
+}
+
+bool EngineCore::loadFNameCacheFile()
+{
+	//names in the same range of indexes, the first and last of every range get compared with the game
+#if UE_VERSION < UE_4_23
+	constexpr int RangeShift = 14;
+#else
+	constexpr int RangeShift = 16;
+#endif
+
+	std::ifstream file(EngineSettings::getWorkingDirectory() / "FNames.bin", std::ios::binary | std::ios::ate);
+	if (!file)
+		return false;
+	const auto fileSize = static_cast<uint64_t>(file.tellg());
+	if (fileSize < sizeof(FNameFileHeader))
+		return false;
+	std::vector<char> data(fileSize);
+	file.seekg(0);
+	file.read(data.data(), static_cast<std::streamsize>(fileSize));
+	if (!file)
+		return false;
 
-	// Sort the vector based on integer keys
-	std::ranges::sort(sortedNames);
+	const auto header = reinterpret_cast<const FNameFileHeader*>(data.data());
+	if (memcmp(header->magic, FNameFileHeader{}.magic, sizeof(header->magic)) != 0 || header->version != FNameFileHeader{}.version)
+		return false;
+	if (header->fingerprint != getTargetFingerprint())
+	{
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "FNames.bin is from a different build, ignoring it");
+		return false;
+	}
+	if (sizeof(FNameFileHeader) + static_cast<uint64_t>(header->count) * sizeof(FNameFileEntry) + header->blobSize != fileSize)
+		return false;
 
-	FNameFile << "FName dump generated by UEDumper by Spuckwaffel.\n\n\n";
+	const auto entries = reinterpret_cast<const FNameFileEntry*>(data.data() + sizeof(FNameFileHeader));
+	const char* blob = data.data() + sizeof(FNameFileHeader) + header->count * sizeof(FNameFileEntry);
+	for (uint32_t i = 0; i < header->count; i++)
+	{
+		if (static_cast<uint64_t>(entries[i].offset) + entries[i].length > header->blobSize)
+			return false;
+		//the entries are sorted, the range check below relies on it
+		if (i > 0 && entries[i].index <= entries[i - 1].index)
+			return false;
+	}
 
-	for (const auto& pair : sortedNames)
+	//the indexes depend on the order the game created its names, which can change between game sessions.
+	//A pool that is smaller than back then or starts with other names is another session
+	uint32_t poolBlock = 0;
+	uint32_t poolCursor = 0;
+	if (readNamePoolState(poolBlock, poolCursor))
 	{
-		progressDone++;
-		char buff[2000] = { 0 };
-		if (pair.second.length() > 1900)
+		const bool bPoolShrunk = poolBlock < header->poolBlock || (poolBlock == header->poolBlock && poolCursor < header->poolCursor);
+		if (bPoolShrunk || hashFirstNameBlock(header->firstBlockBytes) != header->firstBlockHash)
 		{
-			FNameFile << "Name for id " << pair.first << "too long!\n";
-			continue;
+			windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "FNames.bin is from another game session, ignoring it");
+			return false;
 		}
+	}
+
+	//then the first and last name of every range, so names that moved in any of them are noticed
+	auto matchesGame = [&](uint32_t i)
+	{
+		FName fname{};
+		fname.ComparisonIndex = entries[i].index;
+#if WITH_CASE_PRESERVING_NAME
+		fname.DisplayIndex = entries[i].index;
+#endif
+		return readFNameFromMemory(fname) == std::string_view(blob + entries[i].offset, entries[i].length);
+	};
+	for (uint32_t first = 0; first < header->count;)
+	{
+		uint32_t last = first;
+		while (last + 1 < header->count && entries[last + 1].index >> RangeShift == entries[first].index >> RangeShift)
+			last++;
 
-		sprintf_s(buff, sizeof(buff), "[%05d] %s", pair.first, pair.second.c_str());
-		FNameFile << buff << std::endl;
+		if (!matchesGame(first) || !matchesGame(last))
+		{
+			windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "FNames.bin does not match the running game, ignoring it");
+			return false;
+		}
+		first = last + 1;
 	}
+
+	for (uint32_t i = 0; i < header->count; i++)
+		FNameCache.insert(entries[i].index, std::string_view(blob + entries[i].offset, entries[i].length));
+
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Loaded %d FNames from FNames.bin", header->count);
+	return true;
+}
+
+bool EngineCore::generateFNameFile(int& progressDone, int& totalProgress)
+{
+	//size the text buffer grows to before it gets written to the file
+	constexpr size_t flushSize = 4 * 1024 * 1024;
+
+	//the master header contains all the imports sorted
+	std::ofstream FNameFile(EngineSettings::getWorkingDirectory() / "FNames.txt", std::ios::binary);
+
+	totalProgress = FNameCache.size();
+
+	std::string buffer = "FName dump generated by UEDumper by Spuckwaffel.\n\n\n";
+	buffer.reserve(flushSize + 4096);
+
+	//the table is already sorted by the index
+	FNameCache.forEach([&](int index, std::string_view name)
+		{
+			progressDone++;
+
+			//"[%05d] "
+			char indexBuff[16];
+			const auto result = std::to_chars(indexBuff, indexBuff + sizeof(indexBuff), index);
+			const size_t digits = result.ptr - indexBuff;
+			buffer += '[';
+			if (digits < 5)
+				buffer.append(5 - digits, '0');
+			buffer.append(indexBuff, digits);
+			buffer += "] ";
+			buffer += name;
+			buffer += '\n';
+
+			if (buffer.size() >= flushSize)
+			{
+				FNameFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				buffer.clear();
+			}
+		});
+	FNameFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
 	FNameFile.close();
 
+	saveFNameCacheFile();
+
 	progressDone = totalProgress;
 
 	return true;
@@ -293,14 +959,36 @@ bool EngineCore::generateStructOrClass(UStruct* object, std::vector<EngineStruct
 
 	}
 
-#if UE_VERSION < UE_4_25
-	if (object->Children)
-	{
-
-		for (auto child = object->getChildren(); child; child = child->getNext())
-		{
+#if USE_LAZY_MEMBERS
+	//only the header, the rest gets read once the struct gets used (materializeStruct).
+	//The maxSize of the supers depends on the first member, so that one gets read already
+	generateMembers(object, eStruct, true);
+	eStruct.firstMemberOffset = eStruct.definedMembers.empty() ? -1 : eStruct.definedMembers[0].offset;
+	eStruct.definedMembers.clear();
+	eStruct.bMaterialized = false;
+	++unmaterializedStructs;
+#else
+	generateMembers(object, eStruct, false);
+	// get struct functions
+	generateFunctions(object, eStruct.functions);
+#endif
+	if (ObjectsManager::CRITICAL_STOP_CALLED())
+		return false;
+	data.push_back(eStruct);
+
+	return true;
+}
+
+void EngineCore::generateMembers(UStruct* object, EngineStructs::Struct& eStruct, bool bFirstOnly)
+{
+#if UE_VERSION < UE_4_25
+	if (object->Children)
+	{
+
+		for (auto child = object->getChildren(); child; child = child->getNext())
+		{
 			if (ObjectsManager::CRITICAL_STOP_CALLED())
-				return false;
+				return;
 
 			if (!child || !child->IsA<UProperty>())
 				continue;
@@ -335,6 +1023,8 @@ bool EngineCore::generateStructOrClass(UStruct* object, std::vector<EngineStruct
 				member.bitOffset = bitPos;
 			}
 			eStruct.definedMembers.push_back(member);
+			if (bFirstOnly)
+				return;
 		}
 	}
 
@@ -378,14 +1068,102 @@ bool EngineCore::generateStructOrClass(UStruct* object, std::vector<EngineStruct
 				member.bitOffset = bitPos;
 			}
 			eStruct.definedMembers.push_back(member);
+			if (bFirstOnly)
+				return;
 		}
 	}
 #endif
-	// get struct functions
-	generateFunctions(object, eStruct.functions);
-	data.push_back(eStruct);
+}
 
-	return true;
+void EngineCore::prefetchMemberChains(const std::vector<uint64_t>& structPtrs, int maxLevels)
+{
+	//we need the UStruct members to find the chain heads
+	ObjectsManager::growUObjects(structPtrs, sizeof(UStruct));
+
+	//the current node of every chain. UFields are already cached, they just get read at full size.
+	//FFields are not cached at all yet.
+	std::vector<uint64_t> fieldLevel;
+#if UE_VERSION >= UE_4_25
+	std::vector<uint64_t> propertyLevel;
+#endif
+
+	auto addChainHeads = [&](const UStruct* struc)
+	{
+		if (struc->Children)
+			fieldLevel.push_back(reinterpret_cast<uint64_t>(struc->Children));
+#if UE_VERSION >= UE_4_25
+		if (struc->ChildProperties)
+			propertyLevel.push_back(reinterpret_cast<uint64_t>(struc->ChildProperties));
+#endif
+	};
+
+	for (const auto structPtr : structPtrs)
+	{
+		if (const auto struc = ObjectsManager::getUObject<UStruct>(structPtr))
+			addChainHeads(struc);
+	}
+
+	//corrupted chains could point back, never visit a node twice
+	std::unordered_set<uint64_t> visited;
+	int levels = 0;
+	size_t nodes = 0;
+	while (levels < maxLevels && (!fieldLevel.empty()
+#if UE_VERSION >= UE_4_25
+		|| !propertyLevel.empty()
+#endif
+		))
+	{
+		if (ObjectsManager::CRITICAL_STOP_CALLED())
+			return;
+
+		std::vector<uint64_t> currentFields;
+		currentFields.swap(fieldLevel);
+		std::erase_if(currentFields, [&](const uint64_t ptr) { return !visited.insert(ptr).second; });
+
+		//every node only as big as its class says
+		ObjectsManager::growUObjectsToClassSize(currentFields);
+
+		std::vector<uint64_t> functionPtrs;
+		for (const auto fieldPtr : currentFields)
+		{
+			const auto field = ObjectsManager::getUObject<UField>(fieldPtr);
+			if (!field)
+				continue;
+
+			if (field->Next)
+				fieldLevel.push_back(reinterpret_cast<uint64_t>(field->Next));
+
+			//functions have their params as own chains
+			if (field->IsA<UFunction>())
+				addChainHeads(field->castTo<UStruct>());
+		}
+		nodes += currentFields.size();
+
+#if UE_VERSION >= UE_4_25
+		std::vector<uint64_t> currentProperties;
+		currentProperties.swap(propertyLevel);
+		std::erase_if(currentProperties, [&](const uint64_t ptr) { return !visited.insert(ptr).second; });
+
+		ObjectsManager::prefetchFFields(currentProperties);
+
+		std::vector<uint64_t> fieldClassPtrs;
+		for (const auto propertyPtr : currentProperties)
+		{
+			const auto property = ObjectsManager::getFField<FField>(propertyPtr);
+			if (!property)
+				continue;
+
+			if (property->Next)
+				propertyLevel.push_back(reinterpret_cast<uint64_t>(property->Next));
+			fieldClassPtrs.push_back(reinterpret_cast<uint64_t>(property->ClassPrivate));
+		}
+		ObjectsManager::prefetchFFieldClasses(fieldClassPtrs);
+		nodes += currentProperties.size();
+#endif
+		levels++;
+	}
+
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Prefetched %llu chain nodes of %llu structs in %d levels", nodes, structPtrs.size(), levels);
 }
 
 template<typename T>
@@ -531,99 +1309,134 @@ for (auto fieldChild = object->getChildren(); fieldChild; fieldChild = fieldChil
 
 bool EngineCore::RUNAddMemberToMemberArray(EngineStructs::Struct & eStruct, const EngineStructs::Member & newMember)
 {
-	//basic 0(1) checks before iterating
+	return RUNImportMembers(eStruct, { newMember })[0].accepted;
+}
 
-	//below class base offset? 
-	if (newMember.offset < eStruct.getInheritedSize())
-	{
-		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "CORE", "Add member failed: offset 0x%X is below base class offset 0x%X!", newMember.offset, eStruct.getInheritedSize());
-		return false;
-	}
-	//above class?
-	if (newMember.offset > eStruct.size)
+std::vector<MemberImportResult> EngineCore::RUNImportMembers(EngineStructs::Struct & eStruct, const std::vector<EngineStructs::Member>&members)
+{
+	std::vector<MemberImportResult> results(members.size());
+	auto reject = [&](size_t index, const char* fmt, auto... args)
 	{
-		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "CORE", "Add member failed: offset 0x%X is greater than class size 0x%X!", newMember.offset, eStruct.size);
-		return false;
-	}
-	//offset + size larger than class size?
-	if (newMember.offset + newMember.size > eStruct.size)
+		char buf[300];
+		sprintf_s(buf, fmt, args...);
+		results[index].reason = buf;
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "CORE", "Add member %s failed: %s", members[index].name.c_str(), buf);
+	};
+
+	//basic 0(1) checks before merging
+	std::vector<size_t> candidates;
+	candidates.reserve(members.size());
+	for (size_t i = 0; i < members.size(); i++)
 	{
-		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "CORE", "Add member failed: offset 0x%X with size %d is greater than class size 0x%X!", newMember.offset + newMember.size, eStruct.size);
-		return false;
+		const auto& newMember = members[i];
+		//below class base offset? 
+		if (newMember.offset < eStruct.getInheritedSize())
+			reject(i, "offset 0x%X is below base class offset 0x%X!", newMember.offset, eStruct.getInheritedSize());
+		//above class?
+		else if (newMember.offset > eStruct.size)
+			reject(i, "offset 0x%X is greater than class size 0x%X!", newMember.offset, eStruct.size);
+		//offset + size larger than class size?
+		else if (newMember.offset + newMember.size > eStruct.size)
+			reject(i, "offset 0x%X with size %d is greater than class size 0x%X!", newMember.offset, newMember.size, eStruct.size);
+		//larger than class size? Thats weird and will only happen if offset is negative otherwise handled by above
+		else if (newMember.size > eStruct.size - eStruct.getInheritedSize())
+			reject(i, "member is too large for class (%d / %d)", newMember.size, eStruct.size - eStruct.getInheritedSize());
+		else
+			candidates.push_back(i);
 	}
 
-	//larger than class size? Thats weird and will only happen if offset is negative otherwise handled by above
-	if (newMember.size > eStruct.size - eStruct.getInheritedSize())
+	//members are ordered by offset, bits in the same byte by their bitOffset
+	auto isBefore = [](const EngineStructs::Member& a, const EngineStructs::Member& b)
 	{
-		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "CORE", "Add member failed: member is too large for class (%d / %d)", newMember.size, eStruct.size - eStruct.getInheritedSize());
-		return false;
-	}
+		if (a.offset != b.offset)
+			return a.offset < b.offset;
+		return (a.isBit ? a.bitOffset : -1) < (b.isBit ? b.bitOffset : -1);
+	};
+	std::ranges::stable_sort(candidates, [&](size_t a, size_t b) { return isBefore(members[a], members[b]); });
 
-	//empty? Mostly the case if the struct has just a unknownmember and nothing defined
-	if (eStruct.definedMembers.size() == 0)
+	//first is the member with the lower (or same) offset. Returns the reason why they collide, nullptr if they dont
+	auto getCollision = [](const EngineStructs::Member& first, const EngineStructs::Member& second) -> const char*
 	{
-		//nothing really needed to check
-		eStruct.definedMembers.push_back(newMember);
-	}
+		//occurence can only happen if both members are a bit. if not, error
+		if (first.offset == second.offset)
+		{
+			if (!first.isBit || !second.isBit)
+				return "attempted to override a existing member (one of them is not a bit)";
+			if (first.bitOffset == second.bitOffset)
+				return "attempted to override a existing member (both have the same bitOffset)";
+			return nullptr;
+		}
+		if (first.offset + first.size > second.offset)
+			return "member is interferring other member";
+		return nullptr;
+	};
 
-	for (int i = 0; i < eStruct.definedMembers.size(); i++)
+	//one pass over the existing members, every candidate only has to be checked against its two neighbours
+	const auto& existing = eStruct.definedMembers;
+	std::vector<EngineStructs::Member> merged;
+	merged.reserve(existing.size() + candidates.size());
+	size_t next = 0;
+	int accepted = 0;
+	for (const size_t index : candidates)
 	{
-		const auto& nextMember = eStruct.definedMembers[i];
+		const auto& newMember = members[index];
+		while (next < existing.size() && !isBefore(newMember, existing[next]))
+			merged.push_back(existing[next++]);
 
-		//check if its smaller than the next member
-		if (newMember.offset < nextMember.offset)
+		if (!merged.empty())
 		{
-			//is the new member somehow interferring the next member
-			if (newMember.offset + newMember.size > nextMember.offset)
+			if (const auto collision = getCollision(merged.back(), newMember))
 			{
-				windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "CORE", "Add member failed: member is interferring other member (0x%X -> 0x%X -!- 0x%X)", newMember.offset, newMember.offset + newMember.size, nextMember.offset);
-				return false;
+				reject(index, "%s (%s at 0x%X)", collision, merged.back().name.c_str(), merged.back().offset);
+				continue;
 			}
-			//yep we found place
-			eStruct.definedMembers.insert(eStruct.definedMembers.begin() + i, newMember);
-			return true;
 		}
-		//occurence can only happen if both members are a bit. if not, error
-		if (newMember.offset == nextMember.offset)
+		if (next < existing.size())
 		{
-			//only allowed if they are bits
-			if (!newMember.isBit || !nextMember.isBit)
-			{
-				windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "CORE", "Add member failed: attempted to override a existing member (one of them is not a bit) (isBit: %d isBit %d)", newMember.isBit, nextMember.isBit);
-				return false;
-			}
-			if (newMember.bitOffset == nextMember.bitOffset)
-			{
-				windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "CORE", "Add member failed: attempted to override a existing member (both have the same botOffset) (%d, %d)", newMember.bitOffset, nextMember.bitOffset);
-				return false;
-			}
-			if (newMember.bitOffset < nextMember.bitOffset)
+			if (const auto collision = getCollision(newMember, existing[next]))
 			{
-				//yep we found place
-				eStruct.definedMembers.insert(eStruct.definedMembers.begin() + i, newMember);
-				return true;
+				reject(index, "%s (%s at 0x%X)", collision, existing[next].name.c_str(), existing[next].offset);
+				continue;
 			}
-			//other cases like > are skipped, they should be checked in the next iter
-		}
-		//all cases should be handled in the next iteration as the member is larger
-
-		//exception: this was the last iteration
-		if (i == eStruct.definedMembers.size() - 1)
-		{
-			//sizes etc are already checked before the loop
-			eStruct.definedMembers.push_back(newMember);
-			return true;
 		}
+		merged.push_back(newMember);
+		results[index].accepted = true;
+		accepted++;
 	}
-	//will never be reached
-	return false;
+	while (next < existing.size())
+		merged.push_back(existing[next++]);
+
+	eStruct.definedMembers = std::move(merged);
+
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "CORE", "Added %d of %d members to %s", accepted, members.size(), eStruct.cppName.c_str());
+	return results;
 }
 
 void EngineCore::cookMemberArray(EngineStructs::Struct & eStruct)
 {
-	//clear the existing array
-	if (!eStruct.cookedMembers.empty())
-		eStruct.cookedMembers.clear();
+	generateCookedMembers(eStruct);
+	//the maxSize is final after cooking
+	eStruct.updateFingerprint();
+}
+
+void EngineCore::generateCookedMembers(EngineStructs::Struct & eStruct)
+{
+	//clear the existing layout, the unknown members of the last cooking are only in there
+	eStruct.layout.clear();
+	eStruct.undefinedMembers.clear();
+
+	//every unknown member has the same type, so it only gets pooled once
+	static const fieldType* unknownType = &TypeList{ fieldType(false, PropertyType::BoolProperty, TYPE_UCHAR) }[0];
+	auto addDefinedMember = [&](int index)
+	{
+		eStruct.layout.add(eStruct.definedMembers[index], true, index);
+	};
+	auto addUndefinedMember = [&](EngineStructs::Member& unknown)
+	{
+		unknown.typeHandle = unknownType;
+		eStruct.undefinedMembers.push_back(unknown);
+		eStruct.layout.add(unknown, false, static_cast<int>(eStruct.undefinedMembers.size()) - 1);
+	};
 
 
 	auto checkRealMemberSize = [&](EngineStructs::Member* currentMember)
@@ -631,7 +1444,7 @@ void EngineCore::cookMemberArray(EngineStructs::Struct & eStruct)
 		//set the real size
 		if (!currentMember->type.isPointer())
 		{
-			if (const auto classObject = getInfoOfObject(currentMember->type.name))
+			if (const auto classObject = getInfoOfType(currentMember->type))
 			{
 				if (classObject->type == ObjectInfo::OI_Struct || classObject->type == ObjectInfo::OI_Class)
 				{
@@ -654,8 +1467,7 @@ void EngineCore::cookMemberArray(EngineStructs::Struct & eStruct)
 		unknown.name = std::string(name);
 		unknown.type = { false, PropertyType::BoolProperty, TYPE_UCHAR };
 		unknown.offset = from;
-		eStruct.undefinedMembers.push_back(unknown);
-		eStruct.cookedMembers.push_back(std::pair(false, eStruct.undefinedMembers.size() - 1));
+		addUndefinedMember(unknown);
 	};
 
 	//end bit exclusive
@@ -719,8 +1531,7 @@ void EngineCore::cookMemberArray(EngineStructs::Struct & eStruct)
 				startBit = startBit % 8;
 				startOffset++;
 			}
-			eStruct.undefinedMembers.push_back(unknown);
-			eStruct.cookedMembers.push_back(std::pair(false, eStruct.undefinedMembers.size() - 1));
+			addUndefinedMember(unknown);
 		}
 	};
 
@@ -775,7 +1586,7 @@ void EngineCore::cookMemberArray(EngineStructs::Struct & eStruct)
 		//bit shit
 		if (currentMember.isBit)
 		{
-			eStruct.cookedMembers.push_back(std::pair(true, i));
+			addDefinedMember(i);
 			if (nextMember.isBit)
 			{
 				//not directly next to it?
@@ -817,7 +1628,6 @@ void EngineCore::cookMemberArray(EngineStructs::Struct & eStruct)
 			}
 			continue;
 		}
-		eStruct.cookedMembers.push_back(std::pair(true, i));
 		//0x2 [0x4]
 		//0x7 [0x2]
 		//->
@@ -826,7 +1636,9 @@ void EngineCore::cookMemberArray(EngineStructs::Struct & eStruct)
 		//0x7 [0x2]
 
 
+		//the layout copies the size, so it has to be the real one first
 		checkRealMemberSize(&currentMember);
+		addDefinedMember(i);
 
 
 		if (nextMember.offset - (currentMember.offset + currentMember.size) > 0)
@@ -841,9 +1653,9 @@ void EngineCore::cookMemberArray(EngineStructs::Struct & eStruct)
 		}
 	}
 	//add the last member
-	eStruct.cookedMembers.push_back(std::pair(true, eStruct.definedMembers.size() - 1));
-	auto last = eStruct.getMemberForIndex(eStruct.cookedMembers.size() - 1);
+	auto last = &eStruct.definedMembers.back();
 	checkRealMemberSize(last);
+	addDefinedMember(static_cast<int>(eStruct.definedMembers.size()) - 1);
 	if (last->offset + last->size < eStruct.maxSize)
 		genUnknownMember(last->offset + last->size, eStruct.maxSize, 7);
 }
@@ -858,8 +1670,7 @@ EngineCore::EngineCore()
 	{
 		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "Loading core...");
 
-		offsets = setOffsets();
-
+		loadOffsets();
 
 		gNames = getOffsetAddress(getOffsetForName("OFFSET_GNAMES"));
 		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "GNames -> 0x%p", gNames);
@@ -895,35 +1706,113 @@ bool EngineCore::initSuccess()
 	return bSuccess;
 }
 
-void EngineCore::cacheFNames(int64_t & finishedNames, int64_t & totalNames, CopyStatus & status)
+void EngineCore::loadOffsets()
+{
+	if (offsets.empty())
+		offsets = setOffsets();
+}
+
+void EngineCore::loadNamePool(int64_t& finishedNames, int64_t& totalNames, CopyStatus& status)
+{
+	status = CS_busy;
+	if (!bNamePoolLoaded)
+	{
+		//names of a previous run of the same build, if they still match we dont have to read anything
+		bNamesFromFile = loadFNameCacheFile();
+		if (!bNamesFromFile)
+		{
+			//read the whole name table at once, the object names only hit the cache then
+			const int64_t cachedNames = bulkCacheFNames(finishedNames, totalNames);
+			if (ObjectsManager::CRITICAL_STOP_CALLED())
+			{
+				status = CS_error;
+				return;
+			}
+			windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "Read %lld FNames from the name table", cachedNames);
+			//the checkpoint of the name table, a retry or the next dump of the same build starts with it
+			saveFNameCacheFile();
+		}
+		bNamePoolLoaded = true;
+	}
+	finishedNames = totalNames;
+	status = CS_success;
+}
+
+void EngineCore::cacheFNames(int64_t & finishedNames, int64_t & totalNames, CopyStatus & status, BoundedQueue<ObjectChunk>* copiedChunks)
 {
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "Caching FNames...");
 	status = CS_busy;
+
+	if (!bNamePoolLoaded)
+	{
+		CopyStatus poolStatus;
+		loadNamePool(finishedNames, totalNames, poolStatus);
+	}
+	const bool bWarmCache = bNamesFromFile;
+
 	totalNames = ObjectsManager::gUObjectManager.UObjectArray.NumElements;
 	finishedNames = 0;
 	bool bIsFirstValidObject = true;
+	bool bInvalidName = false;
 
-	for (; finishedNames < ObjectsManager::gUObjectManager.UObjectArray.NumElements; finishedNames++)
+	//caches the names of the objects [start, end), false once we dont need any more objects
+	auto cacheObjectNames = [&](int32_t start, int32_t end)
 	{
-		const auto object = ObjectsManager::getUObjectByIndex<UObject>(finishedNames);
-		if (!object)
-			continue;
+		if (ObjectsManager::CRITICAL_STOP_CALLED())
+			return false;
+		for (int32_t i = start; i < end; i++, finishedNames++)
+		{
+			const auto object = ObjectsManager::getUObjectByIndex<UObject>(i);
+			if (!object)
+				continue;
 
-		//caches already if not cached, we dont have to use the result
-		auto res = object->getName();
+			//caches already if not cached, we dont have to use the result
+			auto res = object->getName();
 
 #if BREAK_IF_INVALID_NAME
-		if (bIsFirstValidObject && res != "/Script/CoreUObject")
+			if (bIsFirstValidObject && res != "/Script/CoreUObject")
+			{
+				windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "ENGINECORE",
+					"ERROR: The first object name should be always /Script/CoreUObject! Instead got \"%s\".This is most likely the result of a invalid FName offset or no decryption!", res.c_str());
+				bInvalidName = true;
+				return false;
+			}
+			bIsFirstValidObject = false;
+
+#endif
+			//with a warm cache we only check the first name, names that are newer than the file get read once they are used
+			if (bWarmCache)
+				return false;
+		}
+		return true;
+	};
+
+	if (copiedChunks)
+	{
+		//the objects come in while they still get copied
+		ObjectChunk chunk;
+		while (copiedChunks->pop(chunk))
 		{
-			windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "ENGINECORE",
-				"ERROR: The first object name should be always /Script/CoreUObject! Instead got \"%s\".This is most likely the result of a invalid FName offset or no decryption!", res.c_str());
-			status = CS_error;
-			return;
+			if (!cacheObjectNames(chunk.start, chunk.end))
+				break;
 		}
-		bIsFirstValidObject = false;
+		//we might have stopped early, the copy must not wait for us anymore
+		copiedChunks->close();
+	}
+	else
+		cacheObjectNames(0, ObjectsManager::gUObjectManager.UObjectArray.NumElements);
 
-#endif
+	if (bInvalidName || ObjectsManager::CRITICAL_STOP_CALLED())
+	{
+		status = CS_error;
+		return;
 	}
+	finishedNames = totalNames;
+
+	//again with the names that got read since the name table
+	if (!bWarmCache)
+		saveFNameCacheFile();
+
 	status = CS_success;
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "Cached all FNames!");
 }
@@ -947,6 +1836,12 @@ void EngineCore::generatePackages(int64_t& finishedPackages, int64_t& totalPacka
 	totalPackages = ObjectsManager::gUObjectManager.UObjectArray.NumElements;
 	finishedPackages = 0;
 
+	//a retry of the stage adds the userdefined structs again, nothing of the cancelled run may stay
+	overridingStructs.clear();
+	customStructs.clear();
+	customEnums.clear();
+	overridingStructMembers.clear();
+
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "reading overriding structs....");
 	overrideStructs();
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "adding custom structs....");
@@ -955,6 +1850,19 @@ void EngineCore::generatePackages(int64_t& finishedPackages, int64_t& totalPacka
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "adding overriding unknown members....");
 	overrideUnknownMembers();
 
+#if USE_DUMP_CHECKPOINTS && !USE_LAZY_MEMBERS
+	//the custom structs and enums are in the checkpoint already, the overrides above are still needed for the live editor
+	if (loadPackagesCheckpoint())
+	{
+		finishPackages();
+		totalPackages = packages.size();
+		finishedPackages = totalPackages;
+		status = CS_success;
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Loaded %d packages out of the checkpoint!", packages.size());
+		return;
+	}
+#endif
+
 	int numUStructsFound = 0;
 	int numEnumsFound = 0;
 	for (; finishedPackages < ObjectsManager::gUObjectManager.UObjectArray.NumElements; finishedPackages++)
@@ -992,9 +1900,49 @@ void EngineCore::generatePackages(int64_t& finishedPackages, int64_t& totalPacka
 		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "ENGINECORE", "WARN: No Enum objects found");
 	}
 
+	//the packages dont depend on each other until finishPackages, so every package gets generated on its own thread.
+	//Sorting by the name first keeps the merged result the same on every run.
+	//Packages that the filter drops wait in filteredUPackages, they only get generated if a dumped package needs them
+	std::vector<std::pair<std::string, std::vector<UObject*>>> sortedUPackages;
+	std::unordered_map<std::string, std::vector<UObject*>> filteredUPackages;
+	for (auto& [packageName, objects] : upackages)
+	{
+		if (isPackageSelected(packageName))
+			sortedUPackages.push_back(std::pair(packageName, std::move(objects)));
+		else
+			filteredUPackages.insert(std::pair(packageName, std::move(objects)));
+	}
+	std::ranges::sort(sortedUPackages, [](const auto& a, const auto& b) { return a.first < b.first; });
+	if (!filteredUPackages.empty())
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Package filter: %d of %d packages selected", sortedUPackages.size(), upackages.size());
+
+	//read all the member chains and enum names of the packages [start, end) in batches, the generation then only hits the cache
+	auto prefetchPackages = [&sortedUPackages](size_t start, size_t end)
+	{
+		std::vector<uint64_t> structPtrs;
+		std::vector<uint64_t> enumPtrs;
+		for (size_t i = start; i < end; i++)
+		{
+			for (const auto object : sortedUPackages[i].second)
+			{
+				if (object->IsA<UEnum>())
+					enumPtrs.push_back(object->objectptr);
+				else
+					structPtrs.push_back(object->objectptr);
+			}
+		}
+#if USE_LAZY_MEMBERS
+		//the headers only need the first member of every struct
+		prefetchMemberChains(structPtrs, 1);
+#else
+		prefetchMemberChains(structPtrs);
+#endif
+		ObjectsManager::prefetchEnumNames(enumPtrs);
+	};
+
 	//reset the counter to 0 as we are using it again but this time really for packages
 	finishedPackages = 0;
-	totalPackages = upackages.size();
+	totalPackages = sortedUPackages.size();
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Total packages: %d", totalPackages);
 
 
@@ -1010,11 +1958,9 @@ void EngineCore::generatePackages(int64_t& finishedPackages, int64_t& totalPacka
 	for (auto& struc : customEnums)
 		basicType.enums.push_back(struc);
 
-	packages.push_back(basicType);
-
 	std::unordered_map<std::string, std::string> usedNames;
 
-	auto checkForDuplicateNames = [&usedNames](EngineStructs::Package package) {
+	auto checkForDuplicateNames = [&usedNames](const EngineStructs::Package& package) {
 		for (auto& enu : package.enums) {
 			if (usedNames.contains(enu.cppName)) {
 				windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "CORE", "Enum redefinitio in package %s! %s has already been defined in package %s", package.packageName.c_str(), enu.cppName.c_str(), usedNames[enu.cppName].c_str());
@@ -1031,123 +1977,368 @@ void EngineCore::generatePackages(int64_t& finishedPackages, int64_t& totalPacka
 		}
 	};
 
-	//package 0 is reserved for our special defined structs
-	for (auto& package : upackages)
+	std::vector<EngineStructs::Package> generatedPackages(sortedUPackages.size());
+	std::atomic<int64_t> generatedCount = 0;
+	//the UI reads the progress, so only the thread of this stage writes it. The workers only count
+	const auto progressThread = std::this_thread::get_id();
+	//generates the packages [start, end), false if the generation got stopped
+	auto generatePackageRange = [&](size_t start, size_t end)
 	{
-		EngineStructs::Package ePackage;
-		ePackage.packageName = package.first;
-
+		for (size_t i = start; i < end; i++)
+		{
+			if (!generatePackage(sortedUPackages[i].first, sortedUPackages[i].second, generatedPackages[i]))
+				return false;
+			const int64_t count = ++generatedCount;
+			if (std::this_thread::get_id() == progressThread)
+				finishedPackages = count;
+		}
+		return true;
+	};
 
-		for (const auto& object : package.second)
+#if USE_DUMP_PIPELINE
+	//this thread reads the members batch by batch and the workers generate every batch that is read already,
+	//so the reads and the generation overlap instead of waiting for each other.
+	//This stage might run on a worker itself and no other worker might be free, so it never waits for a generator that didnt start
+	struct GeneratorState
+	{
+		BoundedQueue<ObjectChunk> readBatches{ PIPELINE_QUEUE_CAPACITY };
+		bool bDone = false; //generators that start after this only return
+		int runningGenerators = 0;
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+	const auto generatorState = std::make_shared<GeneratorState>();
+	auto& readBatches = generatorState->readBatches;
+	auto generateReadBatches = [&]
+	{
+		ObjectChunk batch;
+		while (readBatches.pop(batch))
 		{
-			const bool isClass = object->IsA<UClass>();
-			if (ObjectsManager::CRITICAL_STOP_CALLED())
+			if (!generatePackageRange(batch.start, batch.end))
+			{
+				readBatches.close();
 				return;
-			if (isClass || object->IsA<UScriptStruct>())
+			}
+		}
+	};
+	for (int i = 1; i < ThreadPool::getThreadCount(); i++)
+	{
+		ThreadPool::submit([generatorState, &generateReadBatches]
 			{
-				auto& dataVector = isClass ? ePackage.classes : ePackage.structs;
-				const auto naming = isClass ? "Class" : "Struct";
-
-
-
-				//is the struct predefined?
-				if (overridingStructs.contains(object->getFullName()))
 				{
-					windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "CORE", "%s %s is predefined!", naming, object->getCName().c_str());
-					auto& struc = overridingStructs[object->getFullName()];
-					//last check, does the cpp name match?
-					if (struc.cppName == object->getCName())
-					{
-						struc.memoryAddress = reinterpret_cast<uintptr_t>(object->getOwnPointer());
-
-						dataVector.push_back(struc);
-
-						auto& generatedStruc = dataVector.back();
-						generatedStruc.isClass = isClass;
-
-						generateFunctions(object->castTo<UStruct>(), generatedStruc.functions);
-
-						windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "CORE", "Total member count: %d | Function count: %d", generatedStruc.cookedMembers.size(), generatedStruc.functions.size());
-
-						continue;
-					}
+					std::lock_guard lock(generatorState->mutex);
+					if (generatorState->bDone)
+						return;
+					generatorState->runningGenerators++;
 				}
+				generateReadBatches();
+				std::lock_guard lock(generatorState->mutex);
+				generatorState->runningGenerators--;
+				generatorState->condition.notify_all();
+			});
+	}
 
-				if (ObjectsManager::CRITICAL_STOP_CALLED())
-					return;
-
-				windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "CORE",
-					"Generating %s %s::%s", naming, ePackage.packageName.c_str(), object->getCName().c_str());
-				printf("Generating %s %s::%s\n", naming, ePackage.packageName.c_str(), object->getCName().c_str());
-
-
-				const auto sObject = object->castTo<UStruct>();
+	for (size_t start = 0; start < sortedUPackages.size(); start += PIPELINE_PACKAGE_BATCH_SIZE)
+	{
+		const size_t end = start + PIPELINE_PACKAGE_BATCH_SIZE < sortedUPackages.size() ? start + PIPELINE_PACKAGE_BATCH_SIZE : sortedUPackages.size();
+		prefetchPackages(start, end);
+		if (ObjectsManager::CRITICAL_STOP_CALLED())
+			break;
+		ObjectChunk batch{ static_cast<int32_t>(start), static_cast<int32_t>(end) };
+		if (readBatches.tryPush(batch))
+			continue;
+		//full, the generators are behind or none of them started. This thread generates the batch then
+		if (readBatches.isClosed() || !generatePackageRange(batch.start, batch.end))
+			break;
+	}
+	readBatches.close();
+	//all members are read, help with the rest
+	generateReadBatches();
+	{
+		std::unique_lock lock(generatorState->mutex);
+		generatorState->bDone = true;
+		generatorState->condition.wait(lock, [&] { return generatorState->runningGenerators == 0; });
+	}
+#else
+	prefetchPackages(0, sortedUPackages.size());
+	ThreadPool::parallelFor(sortedUPackages.size(), 1, [&](size_t start, size_t end) { generatePackageRange(start, end); });
+#endif
+	//the last packages might have been done by the workers
+	finishedPackages = generatedCount;
 
-				if (!generateStructOrClass(sObject, dataVector))
-					continue;
+	if (ObjectsManager::CRITICAL_STOP_CALLED())
+		return;
 
-				auto& generatedStruc = dataVector.back();
-				generatedStruc.isClass = isClass;
+#if PACKAGE_FILTER_PULL_DEPENDENCIES
+	//pull in the filtered packages the generated ones need, round by round until nothing is missing anymore.
+	//The CNames of the filtered objects are only needed for this, so they only get built here
+	std::unordered_map<std::string, std::string> filteredTypePackages;
+	for (const auto& [packageName, objects] : filteredUPackages)
+	{
+		for (const auto object : objects)
+			filteredTypePackages.insert(std::pair(object->getCName(), packageName));
+	}
+	size_t pulledPackages = 0;
+	for (size_t roundStart = 0; !filteredUPackages.empty() && roundStart < sortedUPackages.size();)
+	{
+		std::unordered_set<std::string> neededTypes;
+		for (size_t i = roundStart; i < sortedUPackages.size(); i++)
+			collectValueDependencies(generatedPackages[i], neededTypes);
 
-				windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "CORE", "Total member count: %d | Function count: %d", generatedStruc.definedMembers.size(), generatedStruc.functions.size());
+		std::vector<std::string> neededPackages;
+		for (const auto& typeName : neededTypes)
+		{
+			const auto it = filteredTypePackages.find(typeName);
+			if (it != filteredTypePackages.end() && filteredUPackages.contains(it->second) && std::ranges::find(neededPackages, it->second) == neededPackages.end())
+				neededPackages.push_back(it->second);
+		}
+		if (neededPackages.empty())
+			break;
 
-			}
-			else if (object->IsA<UEnum>())
-			{
-				windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "CORE", "Generating Enum %s", object->getCName().c_str());
-				const auto eObject = object->castTo<UEnum>();
-				if (!generateEnum(eObject, ePackage.enums))
-					continue;
-			}
+		std::ranges::sort(neededPackages);
+		roundStart = sortedUPackages.size();
+		for (const auto& packageName : neededPackages)
+		{
+			sortedUPackages.push_back(std::pair(packageName, std::move(filteredUPackages[packageName])));
+			filteredUPackages.erase(packageName);
 		}
+		pulledPackages += neededPackages.size();
+		totalPackages = sortedUPackages.size();
+		generatedPackages.resize(sortedUPackages.size());
 
-		checkForDuplicateNames(ePackage);
+		prefetchPackages(roundStart, sortedUPackages.size());
+		ThreadPool::parallelFor(sortedUPackages.size() - roundStart, 1, [&](size_t start, size_t end) { generatePackageRange(roundStart + start, roundStart + end); });
+		finishedPackages = generatedCount;
+		if (ObjectsManager::CRITICAL_STOP_CALLED())
+			return;
+	}
+	if (pulledPackages > 0)
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Package filter: pulled in %d packages as dependencies", pulledPackages);
+#endif
 
-		packages.push_back(ePackage);
-		finishedPackages++;
+	//package 0 is reserved for our special defined structs. Nothing goes into the packages before the generation is done,
+	//otherwise a cancelled run would count as cached on the retry
+	packages.push_back(std::move(basicType));
+	for (auto& ePackage : generatedPackages)
+	{
+		checkForDuplicateNames(ePackage);
+		packages.push_back(std::move(ePackage));
 	}
 
 
 	std::ranges::sort(packages, EngineStructs::Package::packageCompare);
 
-	//were done, now we do packageObjectInfos caching, we couldnt do before because pointers are all on stack data and not in the static package vec
+	//were done, now we do symbolInfos caching, we couldnt do before because pointers are all on stack data and not in the static package vec
 	finishPackages();
 
+#if USE_DUMP_CHECKPOINTS && !USE_LAZY_MEMBERS
+	//lazy structs would need their members first, so with USE_LAZY_MEMBERS the packages dont get a checkpoint
+	savePackagesCheckpoint();
+#endif
+
 	status = CS_success;
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Done generating packages!");
 }
 
-std::vector<EngineStructs::Package>& EngineCore::getPackages()
+bool EngineCore::matchesPackagePattern(const std::string& name, const std::string& pattern)
 {
-	return packages;
+	//iterative glob, on a mismatch the last * takes one more character
+	size_t n = 0, p = 0;
+	size_t starPattern = std::string::npos, starName = 0;
+	while (n < name.size())
+	{
+		if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n]))
+		{
+			n++;
+			p++;
+		}
+		else if (p < pattern.size() && pattern[p] == '*')
+		{
+			starPattern = p++;
+			starName = n;
+		}
+		else if (starPattern != std::string::npos)
+		{
+			p = starPattern + 1;
+			n = ++starName;
+		}
+		else
+			return false;
+	}
+	while (p < pattern.size() && pattern[p] == '*')
+		p++;
+	return p == pattern.size();
 }
 
-
-const ObjectInfo* EngineCore::getInfoOfObject(const std::string & CName)
+bool EngineCore::isPackageSelected(const std::string& packageName)
 {
-	//in functions we compare packageIndex and objectIndex anyways so the type doesnt matter
-	if (!packageObjectInfos.contains(CName))
-		return nullptr;
-
-	return &packageObjectInfos[CName];
+	auto matchesAny = [&](const std::vector<std::string>& patterns)
+	{
+		return std::ranges::any_of(patterns, [&](const std::string& pattern) { return matchesPackagePattern(packageName, pattern); });
+	};
+	return (includedPackages.empty() || matchesAny(includedPackages)) && !matchesAny(excludedPackages);
 }
 
-
-const std::vector<std::string>& EngineCore::getAllUnknownTypes()
+void EngineCore::collectValueDependencies(const EngineStructs::Package& package, std::unordered_set<std::string>& typeNames)
 {
-	//already checked? Well then dont do it again
-	if (unknownProperties.size() > 0)
-		return unknownProperties;
-
-	for (auto& pack : packages)
+	//same rules as the dependencyPackages in finishPackages, pointers dont need the type
+	auto addType = [&](const fieldType& type, auto& self) -> void
+	{
+		if (type.clickable && !type.isPointer())
+			typeNames.insert(type.name);
+		for (const auto& subtype : type.subTypes)
+		{
+			if (subtype.propertyType != PropertyType::ObjectProperty && subtype.propertyType != PropertyType::ClassProperty)
+				self(subtype, self);
+		}
+	};
+	for (const auto structs : { &package.structs, &package.classes })
+	{
+		for (const auto& struc : *structs)
+		{
+			for (const auto& superName : struc.superNames)
+				typeNames.insert(superName);
+			for (const auto& member : struc.definedMembers)
+				addType(member.type, addType);
+		}
+	}
+}
+
+bool EngineCore::generatePackage(const std::string& packageName, const std::vector<UObject*>& objects, EngineStructs::Package& ePackage)
+{
+	ePackage.packageName = packageName;
+
+	for (const auto& object : objects)
+	{
+		const bool isClass = object->IsA<UClass>();
+		if (ObjectsManager::CRITICAL_STOP_CALLED())
+			return false;
+		if (isClass || object->IsA<UScriptStruct>())
+		{
+			auto& dataVector = isClass ? ePackage.classes : ePackage.structs;
+			const auto naming = isClass ? "Class" : "Struct";
+
+			//is the struct predefined?
+			if (const auto overridingStruct = overridingStructs.find(object->getFullName()); overridingStruct != overridingStructs.end())
+			{
+				windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "CORE", "%s %s is predefined!", naming, object->getCName().c_str());
+				//last check, does the cpp name match?
+				if (overridingStruct->second.cppName == object->getCName())
+				{
+					//every overriding struct belongs to exactly one object, so no other thread touches it
+					overridingStruct->second.memoryAddress = reinterpret_cast<uintptr_t>(object->getOwnPointer());
+
+					dataVector.push_back(overridingStruct->second);
+
+					auto& generatedStruc = dataVector.back();
+					generatedStruc.isClass = isClass;
+
+#if USE_LAZY_MEMBERS
+					//the members are defined already, only the functions are missing
+					generatedStruc.bMaterialized = false;
+					++unmaterializedStructs;
+#else
+					generateFunctions(object->castTo<UStruct>(), generatedStruc.functions);
+#endif
+
+					continue;
+				}
+			}
+
+			if (ObjectsManager::CRITICAL_STOP_CALLED())
+				return false;
+
+			const auto sObject = object->castTo<UStruct>();
+
+			if (!generateStructOrClass(sObject, dataVector))
+				continue;
+
+			dataVector.back().isClass = isClass;
+		}
+		else if (object->IsA<UEnum>())
+		{
+			const auto eObject = object->castTo<UEnum>();
+			if (!generateEnum(eObject, ePackage.enums))
+				continue;
+		}
+	}
+
+	//one line per package, logging every struct from all threads just fights over the log lock
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "CORE", "Generated package %s | %d structs | %d classes | %d enums",
+		ePackage.packageName.c_str(), ePackage.structs.size(), ePackage.classes.size(), ePackage.enums.size());
+	return true;
+}
+
+std::vector<EngineStructs::Package>& EngineCore::getPackages()
+{
+	return packages;
+}
+
+
+const ObjectInfo* EngineCore::getInfoOfObject(const InternedString& CName)
+{
+	//in functions we compare packageIndex and objectIndex anyways so the type doesnt matter
+	return getInfoOfSymbol(SymbolTable::findId(CName));
+}
+
+const ObjectInfo* EngineCore::getInfoOfObject(const std::string& CName)
+{
+	//a string that was never interned cant be a object
+	InternedString interned;
+	if (!InternedString::find(CName, interned))
+		return nullptr;
+	return getInfoOfObject(interned);
+}
+
+const ObjectInfo* EngineCore::getInfoOfSymbol(uint32_t symbol)
+{
+	if (symbol == 0 || symbol >= symbolInfos.size() || !symbolInfos[symbol].valid)
+		return nullptr;
+	return &symbolInfos[symbol];
+}
+
+const ObjectInfo* EngineCore::getInfoOfType(const fieldType& type)
+{
+	//types that got edited by hand dont have a symbol
+	if (type.symbol)
+		return getInfoOfSymbol(type.symbol);
+	return getInfoOfObject(type.name);
+}
+
+const std::vector<EngineStructs::TypeReference>& EngineCore::getReferencesOfSymbol(uint32_t symbol)
+{
+	static const std::vector<EngineStructs::TypeReference> noReferences{};
+	if (symbol == 0 || symbol >= typeReferences.size())
+		return noReferences;
+	return typeReferences[symbol];
+}
+
+const std::vector<EngineStructs::TypeReference>& EngineCore::getReferencesOfType(const std::string& CName)
+{
+	InternedString interned;
+	if (!InternedString::find(CName, interned))
+		return getReferencesOfSymbol(0);
+	return getReferencesOfSymbol(SymbolTable::findId(interned));
+}
+
+
+const std::vector<std::string>& EngineCore::getAllUnknownTypes()
+{
+	//already checked? Well then dont do it again
+	if (unknownProperties.size() > 0)
+		return unknownProperties;
+
+	materializeAllStructs();
+
+	for (auto& pack : packages)
 	{
 		auto checkMembers = [&](const EngineStructs::Struct& struc) mutable
 		{
 			for (auto& member : struc.definedMembers)
 			{
 				if (!member.type.clickable || //not clickable? Skip
-					packageObjectInfos.contains(member.type.name) || //packageObjectInfos contains the name? Then its defined
-					std::ranges::find(unknownProperties, member.type.name) != unknownProperties.end()) //is it already in the vector? Skip
+					getInfoOfType(member.type) || //the name has a ObjectInfo? Then its defined
+					std::ranges::find(unknownProperties, member.type.name.str()) != unknownProperties.end()) //is it already in the vector? Skip
 					continue;
 
 				unknownProperties.push_back(member.type.name);
@@ -1198,238 +2389,708 @@ void EngineCore::finishPackages()
 {
 	std::unordered_map<std::string, EngineStructs::Enum*> enumLookupTable;
 	std::unordered_map<std::string, int> enumMap = {};
-	std::unordered_set<std::string> duplicatedClassNames{};
 	int duplicatedNames = 0;
-	//were done, now we do packageObjectInfos caching, we couldnt do before because pointers are all on stack data and not in the static package vec
-	for (int i = 0; i < packages.size(); i++)
-	{
-		auto& package = packages[i];
-		package.index = i;
 
-		auto fillMissingDataForStructs = [&](std::vector<EngineStructs::Struct>& structs)
+	//the first definition of a name wins
+	symbolInfos.clear();
+	duplicatedClassSymbols.clear();
+	//the pooled types outlive the packages, none of them may keep a info of the last run
+	TypeListPool::resetInfos();
+
+	//every phase runs on the thread pool and only writes to its own package (or struct). Everything that crosses
+	//packages gets collected per package and merged in package order after the phase, so the result doesnt depend on the threads
+	std::vector<PackageLinks> packageLinks(packages.size());
+
+	//phase 1: owners and indexes. The symbol ids get created here already, the symbol definition after is only lookups
+	ThreadPool::parallelFor(packages.size(), 1, [&](size_t start, size_t end)
 		{
-			for (int j = 0; j < structs.size(); j++)
+			for (size_t i = start; i < end; i++)
 			{
-				auto& struc = structs[j];
-				struc.owningPackage = &package;
-				struc.owningVectorIndex = j;
+				auto& package = packages[i];
+				package.index = static_cast<int>(i);
 
-				const auto OI_type = struc.isClass ? ObjectInfo::OI_Class : ObjectInfo::OI_Struct;
-				if (packageObjectInfos.contains(struc.cppName))
+				auto fillMissingDataForStructs = [&](std::vector<EngineStructs::Struct>& structs)
 				{
-					windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "ENGINECORE", "Duplicate name found: %s", struc.cppName.c_str());
+					for (int j = 0; j < structs.size(); j++)
+					{
+						auto& struc = structs[j];
+						struc.owningPackage = &package;
+						struc.owningVectorIndex = j;
+						struc.embeddedByOthers.clear();
+						SymbolTable::getId(struc.cppName);
+						package.combinedStructsAndClasses.push_back(&struc);
+
+						for (int k = 0; k < struc.functions.size(); k++)
+						{
+							auto& func = struc.functions[k];
+							func.owningVectorIndex = k;
+							func.owningStruct = &struc;
+							package.functions.push_back(&func);
+							SymbolTable::getId(func.cppName);
+						}
+
+						//empty structs have a size of 1
+						if (!struc.isClass && struc.maxSize == 0)
+						{
+							struc.size = 1;
+							struc.maxSize = 1;
+						}
+					}
+				};
 
-					if (!duplicatedClassNames.contains(struc.cppName))
-						duplicatedClassNames.insert(struc.cppName);
-					struc.cppName += "dup_" + std::to_string(duplicatedNames++);
-					
+				fillMissingDataForStructs(package.classes);
+				fillMissingDataForStructs(package.structs);
+
+				for (int j = 0; j < package.enums.size(); j++)
+				{
+					auto& enu = package.enums[j];
+					enu.owningPackage = &package;
+					enu.owningVectorIndex = j;
+					SymbolTable::getId(enu.cppName);
 				}
-				packageObjectInfos.insert(std::pair(struc.cppName, ObjectInfo(true, OI_type, &struc)));
-				package.combinedStructsAndClasses.push_back(&struc);
+			}
+		});
 
-				for (int k = 0; k < struc.functions.size(); k++)
+	//the first definition wins, so this has to go in package order
+	symbolInfos.resize(SymbolTable::size() + 1);
+	for (auto& package : packages)
+	{
+		auto defineStructs = [&](std::vector<EngineStructs::Struct>& structs)
+		{
+			for (auto& struc : structs)
+			{
+				const auto OI_type = struc.isClass ? ObjectInfo::OI_Class : ObjectInfo::OI_Struct;
+				if (getInfoOfObject(struc.cppName))
 				{
-					auto& func = struc.functions[k];
-					func.owningVectorIndex = k;
-					func.owningStruct = &struc;
-					package.functions.push_back(&func);
+					windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "ENGINECORE", "Duplicate name found: %s", struc.cppName.c_str());
 
-					packageObjectInfos.insert(std::pair(func.cppName, ObjectInfo(true, ObjectInfo::OI_Function, &func)));
+					duplicatedClassSymbols.insert(SymbolTable::getId(struc.cppName));
+					struc.cppName += "dup_" + std::to_string(duplicatedNames++);
 
 				}
+				defineSymbol(struc.cppName, ObjectInfo(true, OI_type, &struc));
 
-				//empty structs have a size of 1
-				if(!struc.isClass && struc.maxSize == 0)
-				{
-					struc.size = 1;
-					struc.maxSize = 1;
-				}
+				for (auto& func : struc.functions)
+					defineSymbol(func.cppName, ObjectInfo(true, ObjectInfo::OI_Function, &func));
 			}
 		};
 
-		fillMissingDataForStructs(package.classes);
-		fillMissingDataForStructs(package.structs);
+		defineStructs(package.classes);
+		defineStructs(package.structs);
 
-		for (int j = 0; j < package.enums.size(); j++)
-		{
-			auto& enu = package.enums[j];
-			enu.owningPackage = &package;
-			enu.owningVectorIndex = j;
-			packageObjectInfos.insert(std::pair(enu.cppName, ObjectInfo(true, ObjectInfo::OI_Enum, &enu)));
-		}
+		for (auto& enu : package.enums)
+			defineSymbol(enu.cppName, ObjectInfo(true, ObjectInfo::OI_Enum, &enu));
 	}
 
-	//we have to loop again for dependency tracking and supers
-	for (int i = 0; i < packages.size(); i++)
-	{
-		auto& package = packages[i];
-
-		for (const auto& struc : package.combinedStructsAndClasses)
+	//phase 2: dependency tracking, supers and the type infos. symbolInfos is read only from here on
+	ThreadPool::parallelFor(packages.size(), 1, [&](size_t start, size_t end)
 		{
-			for (const auto& var : struc->definedMembers)
+			for (size_t i = start; i < end; i++)
 			{
-				if (var.type.propertyType == PropertyType::EnumProperty && !enumMap.contains(var.type.name))
+				auto& package = packages[i];
+				auto& links = packageLinks[i];
+				links.package = &package;
+
+				for (const auto& struc : package.combinedStructsAndClasses)
+				{
+					for (auto& name : struc->superNames)
+					{
+						const auto info = getInfoOfObject(name);
+						//a super thats not dumped (package filter) ends the chain, otherwise supers[0] would be the grand super.
+						//The supers that are linked are still the full chain of supers[0]
+						if (!info || !info->valid || (info->type != ObjectInfo::OI_Class && info->type != ObjectInfo::OI_Struct))
+							break;
+						//get the super struct
+						auto superStruc = static_cast<EngineStructs::Struct*>(info->target);
+						//add the super struct as a super, the super gets linked back after this phase
+						struc->supers.push_back(superStruc);
+						//if they arent in the same package, add the supers package as dependency
+						if (superStruc->owningPackage->index != package.index)
+							links.dependencies.push_back(superStruc->owningPackage);
+					}
+					//without the direct super the struct starts at 0, the cooking fills the size of the super with a unknown member
+					if (struc->supers.empty())
+						struc->inherited = false;
+
+					linkStructMembers(struc, links);
+				}
+
+				for (const auto& func : package.functions)
+					linkFunction(func, links);
+
+				for (int j = 0; j < package.enums.size(); j++)
 				{
-					enumMap.insert(std::pair<std::string, int>(var.type.name, var.arrayDim > 0 ? var.size / var.arrayDim : var.size));
+					links.enums.push_back(std::pair<std::string, EngineStructs::Enum*>(generateValidVarName(package.enums[j].cppName), &package.enums[j]));
 				}
 			}
+		});
 
-			for (auto& name : struc->superNames)
+	//merge the links in package order, the first one wins like before
+	typeReferences.clear();
+	typeReferences.resize(SymbolTable::size() + 1);
+	for (int i = 0; i < packages.size(); i++)
+	{
+		auto& links = packageLinks[i];
+		applyLinks(links);
+		for (auto& enumSize : links.enumSizes)
+			enumMap.insert(enumSize);
+		for (auto& enu : links.enums)
+			enumLookupTable.insert(enu);
+
+		for (const auto& struc : packages[i].combinedStructsAndClasses)
+		{
+			for (const auto superStruc : struc->supers)
 			{
-				const auto info = getInfoOfObject(name);
-				if (!info || !info->valid || (info->type != ObjectInfo::OI_Class && info->type != ObjectInfo::OI_Struct))
-					continue;
-				//get the super struct
-				auto superStruc = static_cast<EngineStructs::Struct*>(info->target);
-				//add the super struct as a super
-				struc->supers.push_back(superStruc);
-				//if they arent in the same package, add the supers package as dependency
-				if (superStruc->owningPackage->index != package.index)
-					package.dependencyPackages.insert(superStruc->owningPackage);
 				//add the current struct to the list of super of others of the super
 				superStruc->superOfOthers.push_back(struc);
+				typeReferences[SymbolTable::findId(superStruc->cppName)].push_back(EngineStructs::TypeReference{ EngineStructs::TypeReference::RK_Subclass, struc });
 				//now if our current struct has defined members, we check the size of the super and possibly reduce the maxSize
-				//because of trailing and padding, we choose the lowest member
-				if (struc->definedMembers.size() > 0)
+				//because of trailing and padding, we choose the lowest member. Lazy structs know their first member already
+				const int firstMemberOffset = struc->getFirstMemberOffset();
+				if (firstMemberOffset >= 0 && firstMemberOffset < superStruc->maxSize)
 				{
-					const auto& firstMember = struc->definedMembers[0];
-					if (firstMember.offset < superStruc->maxSize)
-					{
-						superStruc->maxSize = firstMember.offset;
-					}
+					superStruc->maxSize = firstMemberOffset;
 				}
 			}
 
 			//this check works only with broken structs
-			if(struc->supers.size() > 0)
+			if (struc->supers.size() > 0)
 			{
 				//is the super max size is greater than the max size of the struct itself we have some weird cringe struc
 				auto super = struc->supers[0];
-				if(super->maxSize > struc->maxSize)
+				if (super->maxSize > struc->maxSize)
 				{
 					struc->maxSize = super->maxSize;
 					struc->size = super->maxSize;
 				}
 			}
+		}
+	}
+	packageLinks.clear();
+
+	// Correct Enum types based on actual member data (they were previously guessed based on max value).
+	// We iterate over the enum map to assert we cover all enums that have overrides
+	for (auto iter = enumMap.begin(); iter != enumMap.end(); iter++)
+	{
+		if (!enumLookupTable.contains(iter->first) && !overridingStructs.contains(iter->first))
+		{
+			// predefined Enums like EOjbectFlags will hit this condition
+			continue;
+		}
+		enumLookupTable[iter->first]->type = getEnumTypeFromSize(iter->second);
+		enumLookupTable[iter->first]->size = iter->second;
+	}
 
-			for (auto& var : struc->definedMembers)
+	//phase 3: cooking. The unknown blocks of a struct start at the maxSize of its super, so the structs get cooked
+	//in waves by inheritance depth. A wave only starts once every super of it is done
+	std::unordered_map<const EngineStructs::Struct*, int> depths{};
+	std::vector<std::vector<EngineStructs::Struct*>> waves{};
+	auto getDepth = [&](EngineStructs::Struct* struc)
+	{
+		//walk up until we hit a super that we know already
+		std::vector<EngineStructs::Struct*> chain{};
+		int depth = -1;
+		for (auto current = struc; current; current = current->supers.empty() ? nullptr : current->supers[0])
+		{
+			if (const auto it = depths.find(current); it != depths.end())
 			{
-				if (!var.type.clickable)
-					continue;
-				const auto info = getInfoOfObject(var.type.name);
-				if (!info || !info->valid)
-					continue;
+				depth = it->second;
+				break;
+			}
+			//broken super chains that loop are cooked in the wave we are at
+			if (std::ranges::find(chain, current) != chain.end())
+				break;
+			chain.push_back(current);
+		}
+		for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+			depths[*it] = ++depth;
+		return depths[struc];
+	};
+	for (auto& package : packages)
+	{
+		for (auto& struc : package.structs)
+		{
+			const int depth = getDepth(&struc);
+			if (depth >= waves.size())
+				waves.resize(depth + 1);
+			waves[depth].push_back(&struc);
+		}
+		for (auto& clas : package.classes)
+		{
+			const int depth = getDepth(&clas);
+			if (depth >= waves.size())
+				waves.resize(depth + 1);
+			waves[depth].push_back(&clas);
+		}
+	}
 
-				//if the type is a type where dumplicate classes exist, we have to erase it
-				//theres no way to know which one of the dup classes it refers to
-				//or maybe there is a way? maybe in the future with pointers or so....
-				if(duplicatedClassNames.contains(var.type.name))
-				{
-					var.type.clickable = false;
-					var.type.propertyType = PropertyType::Int8Property;
-					var.arrayDim = var.size;
-					var.name += "_unkBecDupClass_" + var.type.name;
-					var.type.name = TYPE_UCHAR;
-				}
+	for (const auto& wave : waves)
+	{
+		ThreadPool::parallelFor(wave.size(), 64, [&](size_t start, size_t end)
+			{
+				for (size_t i = start; i < end; i++)
+					cookMemberArray(*wave[i]);
+			});
+	}
+
+	//the structs got their fingerprint while cooking, the packages sum them up
+	ThreadPool::parallelFor(packages.size(), 8, [&](size_t start, size_t end)
+		{
+			for (size_t i = start; i < end; i++)
+			{
+				for (auto& enu : packages[i].enums)
+					enu.updateFingerprint();
+				packages[i].updateFingerprint();
+			}
+		});
+}
 
-				var.type.info = info;
+void EngineCore::defineSymbol(const InternedString& CName, const ObjectInfo& info)
+{
+	const uint32_t symbol = SymbolTable::getId(CName);
+	if (symbol >= symbolInfos.size())
+		symbolInfos.resize(SymbolTable::size() + 1);
+	if (!symbolInfos[symbol].valid)
+		symbolInfos[symbol] = info;
+}
 
-				for (auto& subtype : var.type.subTypes)
-				{
-					if (!subtype.clickable)
-						continue;
-					const auto subInfo = getInfoOfObject(subtype.name);
-					if (!subInfo || !subInfo->valid)
-						continue;
+void EngineCore::linkStructMembers(EngineStructs::Struct* eStruct, PackageLinks& links)
+{
+	auto addDependency = [&](const ObjectInfo* info)
+	{
+		const auto targetPack = info->type == ObjectInfo::OI_Enum ? static_cast<EngineStructs::Enum*>(info->target)->owningPackage : static_cast<EngineStructs::Struct*>(info->target)->owningPackage;
+		if (targetPack != links.package)
+			links.dependencies.push_back(targetPack);
+	};
 
-					subtype.info = subInfo;
+	for (auto& var : eStruct->definedMembers)
+	{
+		if (var.type.propertyType == PropertyType::EnumProperty)
+			links.enumSizes.push_back(std::pair<std::string, int>(var.type.name, var.arrayDim > 0 ? var.size / var.arrayDim : var.size));
 
-					if (subtype.propertyType != PropertyType::ObjectProperty && subtype.propertyType != PropertyType::ClassProperty)
-					{
-						const auto targetPack = subInfo->type == ObjectInfo::OI_Enum ? static_cast<EngineStructs::Enum*>(subInfo->target)->owningPackage : static_cast<EngineStructs::Struct*>(subInfo->target)->owningPackage;
-						if (targetPack->index != package.index)
-							package.dependencyPackages.insert(targetPack);
-					}
-				}
+		if (!var.type.clickable)
+			continue;
+		//types that got loaded or edited get their symbol here once
+		if (!var.type.symbol)
+			var.type.symbol = SymbolTable::getId(var.type.name);
+		const auto info = getInfoOfSymbol(var.type.symbol);
+		if (!info || !info->valid)
+			continue;
 
-				const auto targetPack = info->type == ObjectInfo::OI_Enum ? static_cast<EngineStructs::Enum*>(info->target)->owningPackage : static_cast<EngineStructs::Struct*>(info->target)->owningPackage;
-				if (targetPack->index != package.index)
-					package.dependencyPackages.insert(targetPack);
+		//if the type is a type where dumplicate classes exist, we have to erase it
+		//theres no way to know which one of the dup classes it refers to
+		//or maybe there is a way? maybe in the future with pointers or so....
+		if (duplicatedClassSymbols.contains(var.type.symbol))
+		{
+			var.type.clickable = false;
+			var.type.propertyType = PropertyType::Int8Property;
+			var.arrayDim = var.size;
+			var.name += "_unkBecDupClass_" + var.type.name;
+			var.type.name = TYPE_UCHAR;
+			var.type.symbol = 0;
+		}
+
+		var.type.info = info;
+		links.embeddedStructs.push_back(std::pair(eStruct, &var));
+
+		//subtypes are shared in the TypeListPool and always have their symbol, other packages use the same ones
+		for (const auto& subtype : var.type.subTypes)
+		{
+			if (!subtype.clickable)
+				continue;
+			const auto subInfo = getInfoOfSymbol(subtype.symbol);
+			if (!subInfo || !subInfo->valid)
+				continue;
+
+			links.pooledTypeInfos.push_back(std::pair(&subtype, subInfo));
+
+			if (subtype.propertyType != PropertyType::ObjectProperty && subtype.propertyType != PropertyType::ClassProperty)
+				addDependency(subInfo);
+		}
+
+		addDependency(info);
+	}
+
+	//after the dup check, the erased types dont reference anything anymore. The types are final now, so they get pooled
+	//here once instead of on every cooking
+	for (int j = 0; j < eStruct->definedMembers.size(); j++)
+	{
+		auto& member = eStruct->definedMembers[j];
+		member.internType();
+		//the erased types keep their info, the pooled unsigned char is shared with everything though
+		if (member.type.clickable && member.type.info)
+			links.pooledTypeInfos.push_back(std::pair(member.typeHandle, member.type.info));
+		forEachTypeSymbol(member.type, [&](uint32_t symbol, bool bSubtype)
+			{
+				links.references.push_back(std::pair(symbol, EngineStructs::TypeReference{ EngineStructs::TypeReference::RK_Member, eStruct, nullptr, j, bSubtype }));
+			});
+	}
+}
 
+void EngineCore::linkFunction(EngineStructs::Function* func, PackageLinks& links)
+{
+	auto addInfoPtr = [&](fieldType& type)
+	{
+		if (type.clickable)
+		{
+			if (!type.symbol)
+				type.symbol = SymbolTable::getId(type.name);
+			const auto info = getInfoOfSymbol(type.symbol);
+			if (info && info->valid)
+			{
+				type.info = info;
+
+				const auto targetPack = info->type == ObjectInfo::OI_Enum ? static_cast<EngineStructs::Enum*>(info->target)->owningPackage : static_cast<EngineStructs::Struct*>(info->target)->owningPackage;
+				if (targetPack != links.package)
+					links.dependencies.push_back(targetPack);
 			}
 		}
+	};
 
-		for (const auto& func : package.functions)
+	auto& ret = func->returnType;
+	addInfoPtr(ret);
+	forEachTypeSymbol(ret, [&](uint32_t symbol, bool bSubtype)
 		{
-			auto& ret = func->returnType;
-			auto addInfoPtr = [&](fieldType& type)
+			links.references.push_back(std::pair(symbol, EngineStructs::TypeReference{ EngineStructs::TypeReference::RK_ReturnType, func->owningStruct, func, 0, bSubtype }));
+		});
+
+	for (int j = 0; j < func->params.size(); j++)
+	{
+		auto& type = std::get<0>(func->params[j]);
+		addInfoPtr(type);
+		forEachTypeSymbol(type, [&](uint32_t symbol, bool bSubtype)
 			{
-				if (type.clickable)
-				{
-					const auto info = getInfoOfObject(type.name);
-					if (info && info->valid)
-					{
-						type.info = info;
+				links.references.push_back(std::pair(symbol, EngineStructs::TypeReference{ EngineStructs::TypeReference::RK_Parameter, func->owningStruct, func, j, bSubtype }));
+			});
+	}
+}
 
-						const auto targetPack = info->type == ObjectInfo::OI_Enum ? static_cast<EngineStructs::Enum*>(info->target)->owningPackage : static_cast<EngineStructs::Struct*>(info->target)->owningPackage;
-						if (targetPack->index != package.index)
-							package.dependencyPackages.insert(targetPack);
-					}
-				}
-			};
-			addInfoPtr(ret);
+void EngineCore::applyLinks(PackageLinks& links)
+{
+	for (const auto dependency : links.dependencies)
+		links.package->dependencyPackages.insert(dependency);
+	for (const auto& [type, info] : links.pooledTypeInfos)
+		type->info = info;
+	for (const auto& [struc, var] : links.embeddedStructs)
+		addEmbeddedStruct(struc, *var);
+	for (auto& [symbol, reference] : links.references)
+	{
+		if (symbol >= typeReferences.size())
+			typeReferences.resize(SymbolTable::size() + 1);
+		typeReferences[symbol].push_back(reference);
+	}
+}
+
+//true on the ui thread while it holds the packagesMutex shared
+static thread_local bool bHoldsPackagesLock = false;
+
+void EngineCore::lockPackagesShared()
+{
+	packagesMutex.lock_shared();
+	bHoldsPackagesLock = true;
+}
+
+void EngineCore::unlockPackagesShared()
+{
+	bHoldsPackagesLock = false;
+	packagesMutex.unlock_shared();
+}
+
+void EngineCore::materializeStruct(EngineStructs::Struct* eStruct)
+{
+	//never anything to do unless USE_LAZY_MEMBERS is on
+	if (!eStruct || unmaterializedStructs == 0)
+		return;
+
+	std::unique_lock lock(materializeMutex, std::defer_lock);
+	if (bHoldsPackagesLock)
+	{
+		//a other thread is materializing and waits for the ui to release the packages, the struct stays lazy for this frame
+		if (!lock.try_lock())
+			return;
+	}
+	else
+		lock.lock();
+	if (eStruct->bMaterialized)
+		return;
+	materializeStructs({ eStruct });
+}
+
+void EngineCore::materializeAllStructs()
+{
+	if (unmaterializedStructs == 0)
+		return;
+
+	std::lock_guard lock(materializeMutex);
+	std::vector<EngineStructs::Struct*> structs;
+	for (auto& package : packages)
+	{
+		for (const auto& struc : package.combinedStructsAndClasses)
+		{
+			if (!struc->bMaterialized)
+				structs.push_back(struc);
+		}
+	}
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Reading the members of %d structs...", structs.size());
+	materializeStructs(structs);
+}
+
+void EngineCore::materializeStructs(const std::vector<EngineStructs::Struct*>& structs)
+{
+	if (structs.empty())
+		return;
+
+	std::vector<uint64_t> structPtrs;
+	structPtrs.reserve(structs.size());
+	for (const auto struc : structs)
+		structPtrs.push_back(struc->memoryAddress);
+	prefetchMemberChains(structPtrs);
 
-			for (auto& param : func->params)
+	//same as in generateStructOrClass, every struct only writes to itself. The ui still shows the lazy structs,
+	//so the members get read into a copy and only get moved in while the packages are locked
+	std::vector<EngineStructs::Struct> readStructs(structs.size());
+	ThreadPool::parallelFor(structs.size(), 16, [&](size_t start, size_t end)
+		{
+			for (size_t i = start; i < end; i++)
 			{
-				auto& type = std::get<0>(param);
-				addInfoPtr(type);
+				const auto struc = structs[i];
+				const auto object = ObjectsManager::getUObject<UStruct>(struc->memoryAddress);
+				if (!object)
+					continue;
+				//predefined structs have their members already
+				if (!overridingStructs.contains(struc->fullName))
+					generateMembers(object, readStructs[i], false);
+				generateFunctions(object, readStructs[i].functions);
 			}
+		});
+
+	//the ui thread already holds it shared and the materializeMutex keeps the other threads out
+	std::unique_lock packagesLock(packagesMutex, std::defer_lock);
+	if (!bHoldsPackagesLock)
+		packagesLock.lock();
+
+	for (size_t i = 0; i < structs.size(); i++)
+	{
+		if (!readStructs[i].definedMembers.empty())
+			structs[i]->definedMembers = std::move(readStructs[i].definedMembers);
+		auto& functions = readStructs[i].functions;
+		structs[i]->functions.insert(structs[i]->functions.end(), std::make_move_iterator(functions.begin()), std::make_move_iterator(functions.end()));
+	}
+	readStructs.clear();
+
+	//the functions did not exist in finishPackages, the symbolInfos is a deque so the handed out pointers stay valid
+	for (const auto struc : structs)
+	{
+		for (int k = 0; k < struc->functions.size(); k++)
+		{
+			auto& func = struc->functions[k];
+			func.owningVectorIndex = k;
+			func.owningStruct = struc;
+			struc->owningPackage->functions.push_back(&func);
+			defineSymbol(func.cppName, ObjectInfo(true, ObjectInfo::OI_Function, &func));
 		}
+	}
+
+	std::vector<PackageLinks> structLinks(structs.size());
+	ThreadPool::parallelFor(structs.size(), 16, [&](size_t start, size_t end)
+		{
+			for (size_t i = start; i < end; i++)
+			{
+				auto& links = structLinks[i];
+				links.package = structs[i]->owningPackage;
+				linkStructMembers(structs[i], links);
+				for (auto& func : structs[i]->functions)
+					linkFunction(&func, links);
+			}
+		});
 
-		for (int j = 0; j < package.enums.size(); j++)
+	//fingerprints of the packages that change
+	std::unordered_set<EngineStructs::Package*> dirtyPackages{};
+	for (auto& links : structLinks)
+	{
+		applyLinks(links);
+		//the enum sizes of finishPackages, the lazy members correct them once they are there
+		for (const auto& [enumName, enumSize] : links.enumSizes)
 		{
-			enumLookupTable.insert(std::pair<std::string, EngineStructs::Enum*>(generateValidVarName(package.enums[j].cppName), &package.enums[j]));
+			const auto info = getInfoOfObject(enumName);
+			if (!info || info->type != ObjectInfo::OI_Enum)
+				continue;
+			const auto enu = static_cast<EngineStructs::Enum*>(info->target);
+			enu->type = getEnumTypeFromSize(enumSize);
+			enu->size = enumSize;
+			enu->updateFingerprint();
+			dirtyPackages.insert(enu->owningPackage);
 		}
+	}
+
+	//the maxSize of the others came from the headers already, so only the new ones need cooking
+	ThreadPool::parallelFor(structs.size(), 16, [&](size_t start, size_t end)
+		{
+			for (size_t i = start; i < end; i++)
+			{
+				structs[i]->bMaterialized = true;
+				cookMemberArray(*structs[i]);
+			}
+		});
+	unmaterializedStructs -= static_cast<int>(structs.size());
+
+	for (const auto struc : structs)
+		dirtyPackages.insert(struc->owningPackage);
+	for (const auto package : dirtyPackages)
+		package->updateFingerprint();
+
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "ENGINECORE", "Materialized %d structs", structs.size());
+}
+
+void EngineCore::addEmbeddedStruct(EngineStructs::Struct* eStruct, const EngineStructs::Member& member)
+{
+	//only members by value take the size of the struct
+	if (!member.type.clickable || member.type.isPointer())
+		return;
+	const auto info = getInfoOfType(member.type);
+	if (!info || (info->type != ObjectInfo::OI_Struct && info->type != ObjectInfo::OI_Class))
+		return;
+	auto& embeddedBy = static_cast<EngineStructs::Struct*>(info->target)->embeddedByOthers;
+	if (std::ranges::find(embeddedBy, eStruct) == embeddedBy.end())
+		embeddedBy.push_back(eStruct);
+}
 
+void EngineCore::forEachTypeSymbol(const fieldType& type, const std::function<void(uint32_t, bool)>& func)
+{
+	auto visit = [&](const fieldType& current, bool bSubtype, auto& self) -> void
+	{
+		if (current.clickable)
+		{
+			//types from the edit window havent resolved their symbol yet
+			const uint32_t symbol = current.symbol ? current.symbol : SymbolTable::getId(current.name);
+			if (symbol)
+				func(symbol, bSubtype);
+		}
+		for (const auto& subtype : current.subTypes)
+			self(subtype, true, self);
+	};
+	visit(type, false, visit);
+}
+
+void EngineCore::updateMemberReferences(EngineStructs::Struct* eStruct, bool bAdd)
+{
+	for (int i = 0; i < eStruct->definedMembers.size(); i++)
+	{
+		forEachTypeSymbol(eStruct->definedMembers[i].type, [&](uint32_t symbol, bool bSubtype)
+			{
+				if (symbol >= typeReferences.size())
+					typeReferences.resize(SymbolTable::size() + 1);
+				auto& references = typeReferences[symbol];
+				if (bAdd)
+					references.push_back(EngineStructs::TypeReference{ EngineStructs::TypeReference::RK_Member, eStruct, nullptr, i, bSubtype });
+				else
+					std::erase_if(references, [&](const EngineStructs::TypeReference& reference) { return reference.kind == EngineStructs::TypeReference::RK_Member && reference.owner == eStruct; });
+			});
 	}
+}
 
-	// Correct Enum types based on actual member data (they were previously guessed based on max value).
-	// We iterate over the enum map to assert we cover all enums that have overrides
-	for (auto iter = enumMap.begin(); iter != enumMap.end(); iter++)
+bool EngineCore::updateMaxSize(EngineStructs::Struct* eStruct)
+{
+	//the same rules as in finishPackages: the first member of any subclass limits the maxSize,
+	//but a struct never gets smaller than its super
+	int maxSize = eStruct->size;
+	for (const auto subclass : eStruct->superOfOthers)
 	{
-		if (!enumLookupTable.contains(iter->first) && !overridingStructs.contains(iter->first))
+		const int firstMemberOffset = subclass->getFirstMemberOffset();
+		if (firstMemberOffset >= 0 && firstMemberOffset < maxSize)
+			maxSize = firstMemberOffset;
+	}
+	if (!eStruct->supers.empty() && eStruct->supers[0]->maxSize > maxSize)
+	{
+		maxSize = eStruct->supers[0]->maxSize;
+		eStruct->size = maxSize;
+	}
+
+	const bool bChanged = eStruct->maxSize != maxSize;
+	eStruct->maxSize = maxSize;
+	return bChanged;
+}
+
+void EngineCore::recookStruct(EngineStructs::Struct* eStruct)
+{
+	//the first member of the edited struct might have moved, which limits the maxSize of its supers.
+	//The supers go first (root to direct super) as every struct depends on the maxSize of its own super
+	std::vector<EngineStructs::Struct*> dirtyStructs{};
+	for (auto it = eStruct->supers.rbegin(); it != eStruct->supers.rend(); ++it)
+	{
+		if (updateMaxSize(*it))
+			dirtyStructs.push_back(*it);
+	}
+	updateMaxSize(eStruct);
+	dirtyStructs.push_back(eStruct);
+
+	//the cooked layout of a struct depends on the maxSize of its super and of every struct it has as member by value.
+	//So everything that inherits or embeds a dirty struct (and so on) is dirty, the rest of the packages stays as it is
+	std::unordered_set<EngineStructs::Struct*> visited(dirtyStructs.begin(), dirtyStructs.end());
+	for (size_t i = 0; i < dirtyStructs.size(); i++)
+	{
+		for (const auto dependents : { &dirtyStructs[i]->superOfOthers, &dirtyStructs[i]->embeddedByOthers })
 		{
-			// predefined Enums like EOjbectFlags will hit this condition
-			continue;
+			for (const auto dependent : *dependents)
+			{
+				if (visited.insert(dependent).second)
+					dirtyStructs.push_back(dependent);
+			}
 		}
-		enumLookupTable[iter->first]->type = getEnumTypeFromSize(iter->second);
-		enumLookupTable[iter->first]->size = iter->second;
 	}
 
-	for (auto& package : packages)
+	//supers before subclasses, like the cooking waves of finishPackages. All maxSizes are final before anything gets cooked,
+	//embedded structs only need theirs
+	std::ranges::stable_sort(dirtyStructs, [](const EngineStructs::Struct* a, const EngineStructs::Struct* b) { return a->supers.size() < b->supers.size(); });
+	for (const auto dirtyStruct : dirtyStructs)
+		updateMaxSize(dirtyStruct);
+
+	std::unordered_set<EngineStructs::Package*> dirtyPackages{};
+	for (const auto dirtyStruct : dirtyStructs)
 	{
-		for (auto& struc : package.structs)
-			cookMemberArray(struc);
-		for (auto& clas : package.classes)
-			cookMemberArray(clas);
+		cookMemberArray(*dirtyStruct);
+		dirtyPackages.insert(dirtyStruct->owningPackage);
 	}
+	for (const auto package : dirtyPackages)
+		package->updateFingerprint();
 
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "CORE", "Cooked %s again with %d dependent structs", eStruct->cppName.c_str(), dirtyStructs.size() - 1);
 }
 
-void EngineCore::runtimeOverrideStructMembers(EngineStructs::Struct * eStruct, const std::vector<EngineStructs::Member>&members)
+std::vector<MemberImportResult> EngineCore::runtimeOverrideStructMembers(EngineStructs::Struct * eStruct, const std::vector<EngineStructs::Member>&members)
 {
 	if (eStruct == nullptr)
-		return;
-	for (const auto& member : members)
+		return std::vector<MemberImportResult>(members.size(), MemberImportResult{ false, "no struct" });
+
+	//the member indexes of the references move with the import
+	updateMemberReferences(eStruct, false);
+	auto results = RUNImportMembers(*eStruct, members);
+	updateMemberReferences(eStruct, true);
+	for (size_t i = 0; i < members.size(); i++)
 	{
-		RUNAddMemberToMemberArray(*eStruct, member);
+		if (results[i].accepted)
+			addEmbeddedStruct(eStruct, members[i]);
 	}
-	cookMemberArray(*eStruct);
+	//the imported members never got linked, so their types get pooled here
+	for (auto& member : eStruct->definedMembers)
+	{
+		if (member.typeHandle)
+			continue;
+		member.internType();
+		const auto info = member.type.clickable ? getInfoOfType(member.type) : nullptr;
+		if (info)
+			TypeListPool::setInfo(*member.typeHandle, info);
+	}
+	//cooked once for all the members
+	recookStruct(eStruct);
+	return results;
 }
 
 void EngineCore::saveToDisk(int& progressDone, int& totalProgress)
 {
-	totalProgress = 1 + FNameCache.size() + packageObjectInfos.size() +
+	//projects always get saved with all the members, loading them never needs the game
+	materializeAllStructs();
+	totalProgress = 1 + FNameCache.size() + symbolInfos.size() +
 		overridingStructs.size() + packages.size() + unknownProperties.size() + customStructs.size() + offsets.size() + 5000;
 	progressDone = 0;
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Saving to disk...");
@@ -1442,8 +3103,10 @@ void EngineCore::saveToDisk(int& progressDone, int& totalProgress)
 	nlohmann::json unordered_maps;
 
 	nlohmann::json jFNameCache;
-	for (const auto& entry : FNameCache)
-		jFNameCache[std::to_string(entry.first)] = entry.second;
+	FNameCache.forEach([&](int index, std::string_view name)
+		{
+			jFNameCache[std::to_string(index)] = std::string(name);
+		});
 	unordered_maps["FNameCache"] = jFNameCache;
 	progressDone += FNameCache.size();
 
@@ -1588,7 +3251,7 @@ bool EngineCore::loadProject(const std::string & filepath, int& progressDone, in
 	nlohmann::json jFNameCache = unordered_maps["FNameCache"];
 	for (auto it = jFNameCache.begin(); it != jFNameCache.end(); ++it)
 	{
-		FNameCache.insert(std::pair(std::stoi(it.key()), it.value()));
+		FNameCache.insert(std::stoi(it.key()), it.value().get<std::string>());
 	}
 
 
@@ -1673,7 +3336,7 @@ void EngineCore::generateStructDefinitionsFile()
 			file << spacing << objectName << ".inherited = " << boolToSt(val.inherited) << ";" << std::endl;
 			file << spacing << objectName << ".isClass = " << boolToSt(val.isClass) << ";" << std::endl;
 			file << spacing << objectName << ".members = std::vector<EngineStructs::Member> {" << std::endl;
-			for (int i = 0; i < val.cookedMembers.size(); i++)
+			for (size_t i = 0; i < val.layout.size(); i++)
 			{
 				auto printFieldType = [&](const fieldType& type) mutable
 				{
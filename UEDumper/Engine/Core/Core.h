@@ -4,6 +4,10 @@
 #include "../structs.h"
 #include "../Userdefined/Offsets.h"
 #include "EngineStructs.h"
+#include "ConcurrentMap.h"
+#include "FNameTable.h"
+#include "BoundedQueue.h"
+#include <shared_mutex>
 
 /****************************************************
 *													*
@@ -15,7 +19,34 @@
 
 #define ENGINE_CORE class
 
+//whether the dump stages overlap instead of waiting for each other. The object copy hands every chunk to the
+//FName caching while it goes on, and the package generation starts with the first packages whose members got read
+#define USE_DUMP_PIPELINE TRUE
+
+//objects per chunk the object copy hands to the FName caching
+#define PIPELINE_OBJECT_CHUNK_SIZE 0x4000
+
+//max chunks that wait between two stages
+#define PIPELINE_QUEUE_CAPACITY 32
+
+//packages that get their members read together before they go to the generation
+#define PIPELINE_PACKAGE_BATCH_SIZE 16
+
+//whether the objects and packages stages save their result in the Checkpoints folder of the working directory. The object
+//pointers are read in whole chunks every time, the checkpoints belong to the hash of that copy. If a dump fails or gets cancelled, the next one of the same game build and object array loads them instead
+//of reading everything again. The names always get saved in FNames.bin. Checkpoints that dont match get replaced by the next dump.
+#define USE_DUMP_CHECKPOINTS TRUE
+
+//version of the packages checkpoint. Increase it whenever the generation code changes, the packages of older checkpoints
+//get generated again then. The userdefined structs of StructDefinitions.h are hashed into the key already
+#define PACKAGES_CHECKPOINT_VERSION 1
+
+//whether the dump only generates the headers (name, size, supers, address) of structs and classes. Members and functions
+//get read the first time the struct is used, the exports read all the missing ones before they start
+#define USE_LAZY_MEMBERS FALSE
+
 //forwarded classes
+class UObject;
 class UEnum;
 class UStruct;
 class UFunction;
@@ -46,10 +77,15 @@ private:
 #endif
 
 	//map that returns the UObject ptr for the full String name
-	inline static std::unordered_map<std::string, uint64_t> fullStringCache{};
+	inline static ConcurrentMap<std::string, uint64_t> fullStringCache{};
 
-	//mal that returns the String of a FNames ComparisonIndex
-	inline static std::unordered_map<int, std::string> FNameCache{};
+	//dense table that returns the String of a FNames ComparisonIndex
+	inline static FNameTable FNameCache{};
+
+	//whether the name table got read (or loaded from FNames.bin) already, see loadNamePool
+	inline static bool bNamePoolLoaded = false;
+	//whether the names came from FNames.bin
+	inline static bool bNamesFromFile = false;
 
 	friend class ObjectsManager;
 
@@ -61,8 +97,35 @@ private:
 	//vector of all packages available
 	inline static std::vector<EngineStructs::Package> packages{};
 
-	//map that returns a ObjectInfo for its given CName
-	inline static std::unordered_map<std::string, ObjectInfo> packageObjectInfos;
+	//ObjectInfos of all defined structs, classes, enums and functions, indexed by the SymbolTable id of their CName.
+	//deque, the functions of lazy structs get added after the pointers got handed out
+	inline static std::deque<ObjectInfo> symbolInfos{};
+
+	//symbols of the CNames that more than one struct had, members with these types get erased
+	inline static std::unordered_set<uint32_t> duplicatedClassSymbols{};
+
+	//structs that only have their header yet (USE_LAZY_MEMBERS)
+	inline static std::atomic<int> unmaterializedStructs = 0;
+	inline static std::mutex materializeMutex;
+	//the ui holds it shared while it renders. Materializing on other threads holds it exclusive while the new members
+	//and functions get added to the symbolInfos, typeReferences and packages
+	inline static std::shared_mutex packagesMutex;
+
+	//links between packages that get found while the structs get linked on multiple threads, applied in order afterwards
+	struct PackageLinks
+	{
+		EngineStructs::Package* package = nullptr; //package the links belong to
+		std::vector<EngineStructs::Package*> dependencies{};
+		std::vector<std::pair<std::string, int>> enumSizes{};
+		std::vector<std::pair<EngineStructs::Struct*, const EngineStructs::Member*>> embeddedStructs{};
+		//infos of the types in the TypeListPool (subtypes and member types), they are shared so they only get set in applyLinks
+		std::vector<std::pair<const fieldType*, const ObjectInfo*>> pooledTypeInfos{};
+		std::vector<std::pair<std::string, EngineStructs::Enum*>> enums{};
+		std::vector<std::pair<uint32_t, EngineStructs::TypeReference>> references{};
+	};
+
+	//every use of a type as member, parameter, return type or super, indexed by the SymbolTable id of the type
+	inline static std::vector<std::vector<EngineStructs::TypeReference>> typeReferences{};
 
 	//array of strings that holds all object names that dont belong to any class but are referenced
 	//null unless function for getting all unknown props get called
@@ -94,6 +157,14 @@ private:
 	 */
 	static bool generateStructOrClass(UStruct* object, std::vector<EngineStructs::Struct>& data);
 
+	/**
+	 * \brief reads the properties of the struct into definedMembers
+	 * \param object UStruct from memory with all its data
+	 * \param eStruct the struct
+	 * \param bFirstOnly stop after the first member, the header of lazy structs needs only that one
+	 */
+	static void generateMembers(UStruct* object, EngineStructs::Struct& eStruct, bool bFirstOnly);
+
 	/**
 	 * \brief generates an enum for the specific enum
 	 * \param object UEnum from memory with all its data
@@ -108,6 +179,134 @@ private:
 	*/
 	static bool generateFunctions(const UStruct* object, std::vector<EngineStructs::Function>& data);
 
+	/**
+	* \brief walks the Children (and ChildProperties) chains of all structs together, one level at a time.
+	* Every level is read with one batched read, so the generation afterwards only hits the cache.
+	* \param structPtrs game pointers of all UStructs that get generated
+	* \param maxLevels stop after this many levels, 1 only reads the chain heads
+	*/
+	static void prefetchMemberChains(const std::vector<uint64_t>& structPtrs, int maxLevels = INT_MAX);
+
+	/**
+	* \brief generates all structs, classes and enums of a package. Thread safe, packages get generated in parallel
+	* \param packageName name of the package
+	* \param objects all UStructs and UEnums of the package
+	* \param ePackage the package that gets filled
+	* \return false if the generation got stopped
+	*/
+	static bool generatePackage(const std::string& packageName, const std::vector<UObject*>& objects, EngineStructs::Package& ePackage);
+
+	/**
+	* \brief matches the name against a glob pattern where * is any amount of characters and ? exactly one
+	* \param name the name
+	* \param pattern the pattern
+	* \return true if the whole name matches
+	*/
+	static bool matchesPackagePattern(const std::string& name, const std::string& pattern);
+
+	/**
+	* \brief checks the package name against the filter in PackageFilter.h
+	* \param packageName name of the package
+	* \return true if the package gets dumped on its own
+	*/
+	static bool isPackageSelected(const std::string& packageName);
+
+	/**
+	* \brief collects the CNames of all types the package needs by value: supers, members and their subtypes
+	* \param package the generated package
+	* \param typeNames set the names get added to
+	*/
+	static void collectValueDependencies(const EngineStructs::Package& package, std::unordered_set<std::string>& typeNames);
+
+	/**
+	* \brief reads the whole name table (FNamePool blocks or TNameEntryArray chunks) with a few big reads,
+	* parses the entries locally and puts every name into the FNameCache
+	* \param finishedNames progress of the read blocks/chunks
+	* \param totalNames number of blocks/chunks
+	* \return number of names that got cached
+	*/
+	static int64_t bulkCacheFNames(int64_t& finishedNames, int64_t& totalNames);
+
+	/**
+	* \brief reads a FName from the game without touching the cache
+	* \param name the FName
+	* \return the string of the FName
+	*/
+	static std::string readFNameFromMemory(FName name);
+
+	//header of FNames.bin, followed by count FNameFileEntries and the string blob
+	struct FNameFileHeader
+	{
+		char magic[4] = { 'U', 'E', 'D', 'N' };
+		uint32_t version = 2;
+		uint64_t fingerprint = 0;
+		uint32_t count = 0;
+		uint32_t reserved = 0;
+		uint64_t blobSize = 0;
+		//name pool when the file got written (>= 4.23). Names only get added, so the pool of the same session can only be bigger
+		uint32_t poolBlock = 0;
+		uint32_t poolCursor = 0;
+		//hash of the start of the first block, a game that created its names in another order has other bytes there
+		uint64_t firstBlockHash = 0;
+		uint32_t firstBlockBytes = 0;
+		uint32_t reserved2 = 0;
+	};
+
+	struct FNameFileEntry
+	{
+		int32_t index;
+		//offset of the name in the blob
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	/**
+	* \brief reads the current block and byte cursor of the name pool
+	* \return false if the pool header looks invalid or the engine has no name pool (< 4.23)
+	*/
+	static bool readNamePoolState(uint32_t& block, uint32_t& cursor);
+
+	/**
+	* \brief hashes the first bytes of the first block of the name pool
+	* \param bytes number of bytes, at most one block
+	* \return the hash
+	*/
+	static uint64_t hashFirstNameBlock(uint32_t bytes);
+
+	/**
+	* \brief writes the whole FName cache into FNames.bin in the working directory
+	* \return true upon success
+	*/
+	static bool saveFNameCacheFile();
+
+	/**
+	* \brief loads FNames.bin into the FName cache if it was made for the same build and still matches the game.
+	* The name pool must not be smaller than when the file got written, the start of its first block must be the same
+	* and the first and last name of every block in the file must match the game
+	* \return true if the names got loaded
+	*/
+	static bool loadFNameCacheFile();
+
+	/**
+	* \brief key of the packages checkpoint. Besides the game build it covers the copied objects, the package filter,
+	* the content of the userdefined structs, overrides and enums of StructDefinitions.h and the generation settings,
+	* so changing them never loads old packages. Any other change to the generation code has to bump PACKAGES_CHECKPOINT_VERSION
+	* \return the key or 0 if there is no valid key
+	*/
+	static uint64_t getPackagesCheckpointKey();
+
+	/**
+	* \brief writes the generated packages into the packages checkpoint
+	* \return true upon success
+	*/
+	static bool savePackagesCheckpoint();
+
+	/**
+	* \brief loads the packages out of the packages checkpoint if the key matches. The packages still need finishPackages
+	* \return true if the packages got loaded
+	*/
+	static bool loadPackagesCheckpoint();
+
 	/**
 	 * \brief adds a member to the member array in case it has place. Only use after generation of the members.
 	 * \param eStruct the target struct
@@ -116,11 +315,94 @@ private:
 	static bool RUNAddMemberToMemberArray(EngineStructs::Struct& eStruct, const EngineStructs::Member& member);
 
 	/**
-	 * \brief (re)generates the cookedmembers array in the given struct
-	 * \param eStruct the struct where the cookedmembers array should be (re)generated
+	 * \brief adds all the members that have place to the member array. The members get sorted once and merged with the
+	 * existing ones in a single pass. Only use after generation of the members, does not cook the struct.
+	 * \param eStruct the target struct
+	 * \param members the members, in any order
+	 * \return one result per member in the order of members
+	 */
+	static std::vector<MemberImportResult> RUNImportMembers(EngineStructs::Struct& eStruct, const std::vector<EngineStructs::Member>& members);
+
+	/**
+	 * \brief (re)generates the cooked layout in the given struct
+	 * \param eStruct the struct where the layout should be (re)generated
 	 */
 	static void cookMemberArray(EngineStructs::Struct& eStruct);
 
+	/**
+	 * \brief fills the layout of the struct with the defined members and the unknown members that fill the gaps
+	 * \param eStruct the struct
+	 */
+	static void generateCookedMembers(EngineStructs::Struct& eStruct);
+
+	/**
+	 * \brief links the struct to the type of the member if the member embeds a struct by value (embeddedByOthers)
+	 * \param eStruct the struct that has the member
+	 * \param member the member
+	 */
+	static void addEmbeddedStruct(EngineStructs::Struct* eStruct, const EngineStructs::Member& member);
+
+	/**
+	 * \brief calls the function for the symbol of the type and every symbol in its subtypes
+	 * \param type the type
+	 * \param func function that gets the symbol and if its a subtype
+	 */
+	static void forEachTypeSymbol(const fieldType& type, const std::function<void(uint32_t, bool)>& func);
+
+	/**
+	 * \brief removes or adds the member references of the struct in typeReferences, used when the members of a struct change at runtime
+	 * \param eStruct the struct
+	 * \param bAdd add the references if true, remove them otherwise
+	 */
+	static void updateMemberReferences(EngineStructs::Struct* eStruct, bool bAdd);
+
+	/**
+	 * \brief calculates the maxSize of the struct again out of its size, the first members of its subclasses and its super
+	 * \param eStruct the struct
+	 * \return true if the maxSize changed
+	 */
+	static bool updateMaxSize(EngineStructs::Struct* eStruct);
+
+	/**
+	 * \brief calculates the maxSize of the struct and its supers again and cooks every struct whose layout depends on
+	 * a changed one again (superOfOthers and embeddedByOthers, recursive), supers before subclasses
+	 * \param eStruct the struct that changed
+	 */
+	static void recookStruct(EngineStructs::Struct* eStruct);
+
+	/**
+	 * \brief gives the CName its ObjectInfo unless the symbol is defined already, the first definition wins
+	 * \param CName the CName
+	 * \param info the info
+	 */
+	static void defineSymbol(const InternedString& CName, const ObjectInfo& info);
+
+	/**
+	 * \brief resolves the member types of the struct. Only writes to the struct, everything else goes into the links
+	 * \param eStruct the struct
+	 * \param links the links of the package of the struct
+	 */
+	static void linkStructMembers(EngineStructs::Struct* eStruct, PackageLinks& links);
+
+	/**
+	 * \brief resolves the return and param types of the function. Only writes to the function, everything else goes into the links
+	 * \param func the function
+	 * \param links the links of the package of the function
+	 */
+	static void linkFunction(EngineStructs::Function* func, PackageLinks& links);
+
+	/**
+	 * \brief applies the dependencies, subtype infos, embedded structs and type references. Not thread safe
+	 * \param links the links
+	 */
+	static void applyLinks(PackageLinks& links);
+
+	/**
+	 * \brief reads the members and functions of the lazy structs on the pool, links and cooks them. Hold the materializeMutex
+	 * \param structs structs that only have their header
+	 */
+	static void materializeStructs(const std::vector<EngineStructs::Struct*>& structs);
+
 public:
 
 	/// constructors
@@ -132,9 +414,31 @@ public:
 
 	static bool initSuccess();
 
+	/**
+	 * \brief fills the offsets with the ones from Offsets.h if that didnt happen yet. The constructor does this as well,
+	 * call it first if something needs the offsets before the EngineCore gets constructed
+	 */
+	static void loadOffsets();
+
 	//Dump generation
 
-	static void cacheFNames(int64_t& finishedNames, int64_t& totalNames, CopyStatus& status);
+	/**
+	 * \brief USE ONLY AFTER CONSTRUCTION! Loads FNames.bin if it matches the game, otherwise reads the whole name table.
+	 * Does not need any objects, so it can run while they get copied
+	 * \param finishedNames progress of the read blocks/chunks
+	 * \param totalNames number of blocks/chunks
+	 * \param status status of the operation
+	 */
+	static void loadNamePool(int64_t& finishedNames, int64_t& totalNames, CopyStatus& status);
+
+	/**
+	 * \brief USE ONLY AFTER UBIGOBJECT GENERATION (or with copiedChunks)! Caches the names of all objects, loads the name pool first if that didnt happen yet
+	 * \param finishedNames objects whose name got cached
+	 * \param totalNames amount of objects
+	 * \param status status of the operation
+	 * \param copiedChunks optional queue of the object copy, the names get cached chunk by chunk while the objects still get copied
+	 */
+	static void cacheFNames(int64_t& finishedNames, int64_t& totalNames, CopyStatus& status, BoundedQueue<ObjectChunk>* copiedChunks = nullptr);
 
 	/// package generation
 
@@ -159,8 +463,44 @@ public:
 	 * \param CName CName  of the UObject
 	 * \return ObjectInfo of the UObject
 	 */
+	static const ObjectInfo* getInfoOfObject(const InternedString& CName);
+
+	/**
+	 * \brief USE ONLY AFTER PACKAGE GENERATION! Converts a CName to a ObjectInfo. The string does not get added to the string pool
+	 * \param CName CName  of the UObject
+	 * \return ObjectInfo of the UObject
+	 */
 	static const ObjectInfo* getInfoOfObject(const std::string& CName);
 
+	/**
+	 * \brief USE ONLY AFTER PACKAGE GENERATION! Gets the ObjectInfo by its symbol id, this is just a array index
+	 * \param symbol SymbolTable id of the CName
+	 * \return ObjectInfo of the UObject or nullptr if nothing is defined with this id
+	 */
+	static const ObjectInfo* getInfoOfSymbol(uint32_t symbol);
+
+	/**
+	 * \brief USE ONLY AFTER PACKAGE GENERATION! Gets the ObjectInfo of the type. Uses the symbol of the type, the name only if it has none
+	 * \param type the type
+	 * \return ObjectInfo of the type
+	 */
+	static const ObjectInfo* getInfoOfType(const fieldType& type);
+
+	/**
+	 * \brief USE ONLY AFTER PACKAGE GENERATION! Gets everything that uses the type: members, function parameters,
+	 * return types and subclasses. Runtime edits of a struct are kept up to date
+	 * \param symbol SymbolTable id of the type name
+	 * \return the references, empty if nothing uses the type
+	 */
+	static const std::vector<EngineStructs::TypeReference>& getReferencesOfSymbol(uint32_t symbol);
+
+	/**
+	 * \brief USE ONLY AFTER PACKAGE GENERATION! Same as getReferencesOfSymbol for the CName of a type
+	 * \param CName the CName of the type
+	 * \return the references, empty if nothing uses the type
+	 */
+	static const std::vector<EngineStructs::TypeReference>& getReferencesOfType(const std::string& CName);
+
 
 
 	/**
@@ -204,14 +544,38 @@ public:
 
 	static void finishPackages();
 
+	/**
+	 * \brief reads the members and functions of the struct if only its header got generated (USE_LAZY_MEMBERS).
+	 * Call it before the members of the struct get used, does nothing if they are there already
+	 * \param eStruct the struct
+	 */
+	static void materializeStruct(EngineStructs::Struct* eStruct);
+
+	/**
+	 * \brief reads the members and functions of every struct that only has its header. The exports call this first.
+	 * Dont call it on the ui thread, a other thread thats materializing at the same time waits for the ui
+	 */
+	static void materializeAllStructs();
+
+	/**
+	 * \brief locks the packages for reading, the ui holds it while it renders a frame. Other threads only add lazy members while nobody holds it
+	 */
+	static void lockPackagesShared();
+
+	/**
+	 * \brief releases the lock of lockPackagesShared
+	 */
+	static void unlockPackagesShared();
+
 	/**
 	 * \brief RUNTIME ONLY! USE ONLY AFTER PACKAGE GENERATION!
 	 * Overrides a existing member in a struct with new one(s)
 	 * \param eStruct pointer to the struct that contains the unknown block
 	 * \param members vector of members to be added
 	 * \param index the member index (that has to be flagged as missed) block of the struct that gets overridden
+	 * \return one result per member, see RUNImportMembers
 	 */
-	static void runtimeOverrideStructMembers(EngineStructs::Struct* eStruct, const std::vector<EngineStructs::Member>& members);
+	static std::vector<MemberImportResult> runtimeOverrideStructMembers(EngineStructs::Struct* eStruct, const std::vector<EngineStructs::Member>& members);
 
 	/**
 	 * \brief ONLY AFTER FULL PACKAGE GENERATION!
@@ -239,6 +603,14 @@ public:
 	 */
 	static std::string FNameToString(FName name);
 
+	/**
+	 * \brief USE ONLY AFTER UBIGOBJECT GENERATION! Converts a FName to string without copying it.
+	 * The view points into the name cache and stays valid, it is always null terminated
+	 * \param name FName of the object
+	 * \return view of the FNames string
+	 */
+	static std::string_view FNameToStringView(FName name);
+
 	/**
 	 * \brief returns the address of the Offset element
 	 * \param offset Offset struct
@@ -259,7 +631,23 @@ public:
 	 */
 	static std::vector<Offset> getOffsets();
 
+	/**
+	 * \brief writes all cached FNames into FNames.txt and FNames.bin in the working directory
+	 */
 	static bool generateFNameFile(int& progressDone, int& totalProgress);
 
+	/**
+	 * \brief hash of the targets PE headers and the dumper settings, changes with every new build of the game
+	 * \return the fingerprint or 0 if the headers could not be read
+	 */
+	static uint64_t getTargetFingerprint();
+
+	/**
+	 * \brief path of a checkpoint file in the Checkpoints folder of the working directory, creates the folder if needed
+	 * \param name name of the file
+	 * \return the path
+	 */
+	static std::filesystem::path getCheckpointPath(const std::string& name);
+
 };
 
@@ -2,11 +2,28 @@
 #include <algorithm>
 #include <vector>
 #include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <mutex>
 #include <set>
 
 #include "../structs.h"
+#include "StringPool.h"
+#include "SymbolTable.h"
+#include "Fingerprint.h"
 #include "Engine/Userdefined/Datatypes.h"
 
+//interned strings are saved as normal strings
+inline void to_json(nlohmann::json& json, const InternedString& str)
+{
+	json = str.str();
+}
+
+inline void from_json(const nlohmann::json& json, InternedString& str)
+{
+	str = InternedString(json.get<std::string>());
+}
+
 //objectinfo struct that holds the info of a defined struct/class/enum/function
 struct ObjectInfo
 {
@@ -51,23 +68,66 @@ struct ObjectInfo
 	}
 };
 
+struct fieldType;
+
+/**
+ * \brief Immutable list of subtypes. Identical lists (hash consed, the subtypes of the subtypes are lists of the pool again)
+ * only exist once in the TypeListPool, so a TArray<FString> that is used by thousands of members is just one pointer.
+ * Comparing two lists is a pointer compare.
+ */
+class TypeList
+{
+	const std::vector<fieldType>* list = nullptr;
+
+public:
+
+	TypeList() = default;
+
+	TypeList(const std::vector<fieldType>& types);
+
+	TypeList(std::initializer_list<fieldType> types);
+
+	size_t size() const { return list ? list->size() : 0; }
+
+	bool empty() const { return size() == 0; }
+
+	const fieldType& operator[](size_t index) const;
+
+	const fieldType& at(size_t index) const;
+
+	const fieldType* begin() const;
+
+	const fieldType* end() const;
+
+	/**
+	 * \brief the list is immutable, this interns a new list with the type appended and points to that one
+	 */
+	void push_back(const fieldType& type);
+
+	bool operator==(const TypeList& other) const { return list == other.list; }
+
+	const std::vector<fieldType>* getPooledList() const { return list; }
+};
+
 //type struct that is used for a field in the package
 struct fieldType
 {
-	//linked info if valid
-	const ObjectInfo* info = nullptr;
+	//linked info if valid. Mutable because the subtypes are shared in the TypeListPool, every pooled type gets resolved once
+	mutable const ObjectInfo* info = nullptr;
 	//clickable if redirection is supported
 	bool clickable = false;
 	//typedef of the type
 	PropertyType propertyType = PropertyType::Unknown;
 	//typedef but better naming case. This is needed as some properties have multiple names (bool <-> unsigned char)
-	std::string name = "";
+	InternedString name{};
+	//symbol id of the name, resolved once when the type gets created. 0 if the type is not clickable or the name got set by hand
+	uint32_t symbol = 0;
 
 	//int size_internal; //useless most of the time because we have engine size, just good for TArray or TSet for easier access to the sizes in live editor
 
-	//a subtype is a (maybe) clickable type. Sometimes there exist more, so vector.
+	//a subtype is a (maybe) clickable type. Sometimes there exist more, so a list.
 	//it makes it possible to click objects e.g in a TArray<x,y> for redirection
-	std::vector<fieldType> subTypes = {};
+	TypeList subTypes{};
 
 	fieldType() {}
 
@@ -76,6 +136,7 @@ struct fieldType
 		this->clickable = clickable;
 		this->propertyType = propertyType;
 		this->name = name;
+		this->symbol = clickable ? SymbolTable::getId(this->name) : 0;
 	}
 
 	fieldType(bool clickable, PropertyType propertyType, const std::string& name, const std::vector<fieldType>& subTypes)
@@ -83,6 +144,7 @@ struct fieldType
 		this->clickable = clickable;
 		this->propertyType = propertyType;
 		this->name = name;
+		this->symbol = clickable ? SymbolTable::getId(this->name) : 0;
 		this->subTypes = subTypes;
 	}
 
@@ -204,15 +266,164 @@ struct fieldType
 		t.clickable = json["c"];
 		t.propertyType = json["p"];
 		t.name = json["n"];
+		t.symbol = t.clickable ? SymbolTable::getId(t.name) : 0;
+		std::vector<fieldType> subTypes;
 		for (const nlohmann::json& subType : json["s"])
-			t.subTypes.push_back(fromJson(subType));
+			subTypes.push_back(fromJson(subType));
+		t.subTypes = subTypes;
 		return t;
 	}
 
+	//hashes the type tree by name, the symbol and info differ between runs
+	void addToFingerprint(Fingerprint& fp) const
+	{
+		fp.add(static_cast<int64_t>(propertyType));
+		fp.add(static_cast<int64_t>(clickable));
+		fp.add(std::string_view(name.str()));
+		fp.add(static_cast<int64_t>(subTypes.size()));
+		for (const auto& subType : subTypes)
+			subType.addToFingerprint(fp);
+	}
+
 	operator bool() const { return propertyType != PropertyType::Unknown; }
 
+	//same type tree, the info is not compared as it follows from the name
+	bool operator==(const fieldType& other) const
+	{
+		return clickable == other.clickable && propertyType == other.propertyType && name == other.name && subTypes == other.subTypes;
+	}
+
+};
+
+/**
+ * \brief Pool of all TypeLists. Lists are never freed, the pointers stay valid for the whole process.
+ */
+class TypeListPool
+{
+	//key of a list in the map, the subtypes are pooled already so hashing and comparing only goes one level deep
+	struct ListKey
+	{
+		const std::vector<fieldType>* list;
+
+		bool operator==(const ListKey& other) const
+		{
+			return *list == *other.list;
+		}
+	};
+
+	struct ListKeyHash
+	{
+		size_t operator()(const ListKey& key) const noexcept
+		{
+			size_t hash = key.list->size();
+			for (const auto& type : *key.list)
+			{
+				hash = hash * 31 + type.name.getHandle();
+				hash = hash * 31 + static_cast<size_t>(type.propertyType) * 2 + type.clickable;
+				hash = hash * 31 + reinterpret_cast<size_t>(type.subTypes.getPooledList());
+			}
+			return hash;
+		}
+	};
+
+	struct PoolData
+	{
+		ConcurrentMap<ListKey, const std::vector<fieldType>*, ListKeyHash> lists{};
+		std::deque<std::vector<fieldType>> storage{};
+		std::mutex writeMutex;
+	};
+
+	//function static, the StructDefinitions create types in static initializers
+	static PoolData& getData()
+	{
+		static PoolData data;
+		return data;
+	}
+
+public:
+
+	/**
+	 * \brief returns the pooled list that equals the given types, adds the list if it is new. Thread safe
+	 * \param types the types
+	 * \return pooled list or nullptr for a empty list
+	 */
+	static const std::vector<fieldType>* intern(const std::vector<fieldType>& types)
+	{
+		if (types.empty())
+			return nullptr;
+
+		PoolData& data = getData();
+		if (const auto list = data.lists.find(ListKey{ &types }))
+			return *list;
+
+		std::lock_guard lock(data.writeMutex);
+		if (const auto list = data.lists.find(ListKey{ &types }))
+			return *list;
+
+		auto& stored = data.storage.emplace_back(types);
+		//the symbol follows from the name, so every type in the pool has it resolved already
+		for (auto& type : stored)
+			type.symbol = type.clickable ? SymbolTable::getId(type.name) : 0;
+		data.lists.insert(ListKey{ &stored }, &stored);
+		return &stored;
+	}
+
+	/**
+	 * \brief sets the ObjectInfo of a pooled type. Equal types share the entry, so concurrent writers always write the same info. Thread safe
+	 * \param type a type that lives in the pool
+	 * \param info the info
+	 */
+	static void setInfo(const fieldType& type, const ObjectInfo* info)
+	{
+		std::lock_guard lock(getData().writeMutex);
+		type.info = info;
+	}
+
+	/**
+	 * \brief forgets the ObjectInfo of every pooled type, call it before the infos get rebuilt.
+	 * Types whose name doesnt resolve anymore would point into the old infos otherwise. Thread safe
+	 */
+	static void resetInfos()
+	{
+		PoolData& data = getData();
+		std::lock_guard lock(data.writeMutex);
+		//nested lists are pooled on their own, so one level is enough
+		for (auto& list : data.storage)
+		{
+			for (auto& type : list)
+				type.info = nullptr;
+		}
+	}
+
+	/**
+	 * \brief number of distinct lists
+	 */
+	static size_t size()
+	{
+		std::lock_guard lock(getData().writeMutex);
+		return getData().storage.size();
+	}
 };
 
+inline TypeList::TypeList(const std::vector<fieldType>& types) : list(TypeListPool::intern(types)) {}
+
+inline TypeList::TypeList(std::initializer_list<fieldType> types) : list(TypeListPool::intern(std::vector<fieldType>(types))) {}
+
+inline const fieldType& TypeList::operator[](size_t index) const { return (*list)[index]; }
+
+inline const fieldType& TypeList::at(size_t index) const { return list->at(index); }
+
+inline const fieldType* TypeList::begin() const { return list ? list->data() : nullptr; }
+
+inline const fieldType* TypeList::end() const { return list ? list->data() + list->size() : nullptr; }
+
+inline void TypeList::push_back(const fieldType& type)
+{
+	std::vector<fieldType> types = list ? *list : std::vector<fieldType>{};
+	types.push_back(type);
+	list = TypeListPool::intern(types);
+}
+
 //copystatus error used in the dump progress
 enum CopyStatus
 {
@@ -222,6 +433,20 @@ enum CopyStatus
 	CS_error
 };
 
+//range [start, end) of object indexes that one dump stage hands to the next one
+struct ObjectChunk
+{
+	int32_t start = 0;
+	int32_t end = 0;
+};
+
+//outcome of one member of a member import, reason is empty if it got accepted
+struct MemberImportResult
+{
+	bool accepted = false;
+	std::string reason{};
+};
+
 //used for the packages
 namespace EngineStructs
 {
@@ -234,7 +459,7 @@ namespace EngineStructs
 	{
 
 		fieldType type; //type of the member
-		std::string name; //name of the member
+		InternedString name; //name of the member
 		int offset = 0; //offset of the member (real offset)
 		int size = 0; //total size of the member (size * arrayDim)
 		int arrayDim = 0; // the number of elements if it's an array (e.g. int16_t foobar[123])
@@ -242,11 +467,21 @@ namespace EngineStructs
 		bool isBit = false; //if the member is a bit (": 1")
 		int bitOffset = 0; //the offset of the bit (0 if not bit)
 		bool userEdited = false; //if the member is edited by a user
+		//the type in the TypeListPool, shared by every member with the same type. Set by internType once the type is final
+		const fieldType* typeHandle = nullptr;
 
 		operator bool() const { return size > 0; }
 
 		bool operator==(Member obj) const { return obj.name == name && obj.offset == offset && obj.bitOffset == bitOffset; }
 
+		//points the typeHandle to the pooled type, call it again whenever the type changed
+		void internType()
+		{
+			//a single type is pooled as list of one, equal types share the same handle then
+			const TypeList pooled{ type };
+			typeHandle = &pooled[0];
+		}
+
 		nlohmann::json toJson() const
 		{
 			nlohmann::json j;
@@ -288,8 +523,8 @@ namespace EngineStructs
 		uintptr_t memoryAddress;
 		fieldType returnType;
 		std::vector<std::tuple<fieldType, std::string, uint64_t, uint64_t>> params; //fieldType, name, propertyFlags, arrayDim
-		std::string fullName;
-		std::string cppName;
+		InternedString fullName;
+		InternedString cppName;
 		std::string functionFlags;
 		uint64_t binaryOffset = 0; //offset of the func in the binary
 
@@ -324,6 +559,86 @@ namespace EngineStructs
 		}
 	};
 
+	/**
+	 * \brief Packed member layout of a struct in cooked order (structure of arrays). Walking the layout of a struct
+	 * only touches these few contiguous arrays instead of every fat Member. The cooking fills it, it is the only cooked order.
+	 * It holds copies, so a member that changes in place needs Struct::buildLayout after (and Member::internType if its type changed)
+	 */
+	struct MemberLayout
+	{
+		enum MemberFlags : uint8_t
+		{
+			MF_DEFINED = 1 << 0, //member is in definedMembers, otherwise in undefinedMembers
+			MF_MISSED = 1 << 1,
+			MF_BIT = 1 << 2,
+			MF_USEREDITED = 1 << 3
+		};
+
+		std::vector<int> offsets{};
+		std::vector<int> sizes{};
+		std::vector<int> arrayDims{};
+		std::vector<uint8_t> bitOffsets{};
+		std::vector<uint8_t> flags{};
+		//handle of the type, points to the type in the TypeListPool and stays valid forever
+		std::vector<const fieldType*> types{};
+		//StringPool handles of the member names
+		std::vector<uint32_t> names{};
+		//index into definedMembers or undefinedMembers (see MF_DEFINED)
+		std::vector<int> memberIndexes{};
+
+		size_t size() const { return offsets.size(); }
+
+		bool isDefined(size_t i) const { return flags[i] & MF_DEFINED; }
+
+		bool isMissed(size_t i) const { return flags[i] & MF_MISSED; }
+
+		bool isBit(size_t i) const { return flags[i] & MF_BIT; }
+
+		bool isUserEdited(size_t i) const { return flags[i] & MF_USEREDITED; }
+
+		const fieldType& getType(size_t i) const { return *types[i]; }
+
+		const std::string& getName(size_t i) const { return StringPool::get(names[i]); }
+
+		void clear()
+		{
+			offsets.clear();
+			sizes.clear();
+			arrayDims.clear();
+			bitOffsets.clear();
+			flags.clear();
+			types.clear();
+			names.clear();
+			memberIndexes.clear();
+		}
+
+		void reserve(size_t count)
+		{
+			offsets.reserve(count);
+			sizes.reserve(count);
+			arrayDims.reserve(count);
+			bitOffsets.reserve(count);
+			flags.reserve(count);
+			types.reserve(count);
+			names.reserve(count);
+			memberIndexes.reserve(count);
+		}
+
+		void add(const Member& member, bool defined, int memberIndex)
+		{
+			offsets.push_back(member.offset);
+			sizes.push_back(member.size);
+			arrayDims.push_back(member.arrayDim);
+			bitOffsets.push_back(static_cast<uint8_t>(member.bitOffset));
+			flags.push_back(static_cast<uint8_t>((defined ? MF_DEFINED : 0) | (member.missed ? MF_MISSED : 0) |
+				(member.isBit ? MF_BIT : 0) | (member.userEdited ? MF_USEREDITED : 0)));
+			//the linking interns the types and resolves their info, members that never got linked only get the handle
+			types.push_back(member.typeHandle ? member.typeHandle : &TypeList{ member.type }[0]);
+			names.push_back(member.name.getHandle());
+			memberIndexes.push_back(memberIndex);
+		}
+	};
+
 	/**
 	 * \brief Struct/Class struct. Contains members and information about the Struct/Class
 	 */
@@ -333,11 +648,12 @@ namespace EngineStructs
 		int owningVectorIndex = 0; //the vector index this struct resides in
 		bool isClass = false; //if struct is actually a class. Even if we have in packages a struct and class vector, every struct should know what it is
 		uintptr_t memoryAddress = 0; //the real memory address where the struct is
-		std::string fullName; //the full name of the struct
-		std::string cppName; //the cppName of the struct
+		InternedString fullName; //the full name of the struct
+		InternedString cppName; //the cppName of the struct
 		std::vector<std::string> superNames{}; //all the structs it inherits, empty, only used in package generation
 		std::vector<Struct*> supers{}; //all the structs it inherits
 		std::vector<Struct*> superOfOthers{}; //all the structs that use this class as a super
+		std::vector<Struct*> embeddedByOthers{}; //all the structs that have this struct as member by value, their member size depends on our maxSize
 		bool inherited = false; //if the struct is inherited
 		int maxSize = 0; //the maximum size this struct is "allowed" to have, as size is not accurate due to padding and trailing
 		bool noFixedSize = false; // if this boolean is true, the current struct or class has no specific fixed size, meaning it can change (template classes)
@@ -346,9 +662,12 @@ namespace EngineStructs
 		int unknownCount = 0; //keep track of all missed vars, only used for the package viewer to edit unknowndata
 		std::vector<Member> definedMembers{}; //list of all members that are all valid and known
 		std::vector<Member> undefinedMembers{}; //list of all members that are all valid and known
-		//listing: isDefined, vecIndex;
-		std::vector<std::pair<bool, int>> cookedMembers{}; //list of all members that are aligned and contain padding members, unknown members etc
+		//all members in cooked order (aligned, with the padding and unknown members), only valid after cooking
+		MemberLayout layout{};
 		std::vector<Function> functions{}; //array of all functions of the struct
+		bool bMaterialized = true; //false if only the header got generated yet (USE_LAZY_MEMBERS), see EngineCore::materializeStruct
+		int firstMemberOffset = -1; //offset of the first member of a struct that is not materialized
+		uint64_t fingerprint = 0; //layout hash, equal in every dump as long as the layout didnt change. 0 until materialized
 
 		int getInheritedSize() const
 		{
@@ -357,13 +676,71 @@ namespace EngineStructs
 			return supers[0]->maxSize;
 		}
 
-		Member* getMemberForIndex(int i)
+		//the member behind the layout index
+		Member* getMemberForIndex(size_t i)
+		{
+			return layout.isDefined(i) ? &definedMembers[layout.memberIndexes[i]] : &undefinedMembers[layout.memberIndexes[i]];
+		}
+
+		const Member* getMemberForIndex(size_t i) const
 		{
-			const auto& m = cookedMembers[i];
-			if (m.first)
-				return &definedMembers[m.second];
-			else
-				return &undefinedMembers[m.second];
+			return layout.isDefined(i) ? &definedMembers[layout.memberIndexes[i]] : &undefinedMembers[layout.memberIndexes[i]];
+		}
+
+		//offset of the first defined member, -1 if there is none. The supers maxSize depends on it
+		int getFirstMemberOffset() const
+		{
+			return definedMembers.empty() ? firstMemberOffset : definedMembers[0].offset;
+		}
+
+		/**
+		 * \brief hashes everything that makes up the layout: name, sizes, supers and the defined members.
+		 * The undefined members are left out, they only fill the gaps and follow from the rest
+		 */
+		void updateFingerprint()
+		{
+			if (!bMaterialized)
+			{
+				fingerprint = 0;
+				return;
+			}
+			Fingerprint fp;
+			addToFingerprint(fp);
+			fingerprint = fp.get();
+		}
+
+		//same hash as updateFingerprint, also for structs that never get materialized like the userdefined ones
+		void addToFingerprint(Fingerprint& fp) const
+		{
+			fp.add(std::string_view(cppName.str()));
+			fp.add(std::string_view(fullName.str()));
+			fp.add(static_cast<int64_t>(isClass));
+			fp.add(static_cast<int64_t>(size));
+			fp.add(static_cast<int64_t>(maxSize));
+			fp.add(static_cast<int64_t>(supers.size()));
+			for (const auto super : supers)
+				fp.add(std::string_view(super->cppName.str()));
+			fp.add(static_cast<int64_t>(definedMembers.size()));
+			for (const auto& member : definedMembers)
+			{
+				fp.add(std::string_view(member.name.str()));
+				fp.add(static_cast<int64_t>(member.offset));
+				fp.add(static_cast<int64_t>(member.size));
+				fp.add(static_cast<int64_t>(member.arrayDim));
+				fp.add(static_cast<int64_t>(member.isBit));
+				fp.add(static_cast<int64_t>(member.bitOffset));
+				member.type.addToFingerprint(fp);
+			}
+		}
+
+		//packs the members again in the same order, after members changed in place
+		void buildLayout()
+		{
+			MemberLayout packed;
+			packed.reserve(layout.size());
+			for (size_t i = 0; i < layout.size(); i++)
+				packed.add(*getMemberForIndex(i), layout.isDefined(i), layout.memberIndexes[i]);
+			layout = std::move(packed);
 		}
 
 		bool operator==(const Struct& st) const
@@ -383,6 +760,7 @@ namespace EngineStructs
 			j["sz"] = size;
 			j["msz"] = maxSize;
 			j["uc"] = unknownCount;
+			j["fp"] = fingerprint;
 			nlohmann::json jMembers;
 			for (const auto& member : definedMembers)
 				jMembers.push_back(member.toJson());
@@ -421,11 +799,32 @@ namespace EngineStructs
 		Package* owningPackage = nullptr;
 		int owningVectorIndex = 0;
 		uintptr_t memoryAddress;
-		std::string fullName;
-		std::string cppName;
+		InternedString fullName;
+		InternedString cppName;
 		std::string type;
 		int size;
-		std::vector<std::pair<std::string, int>> members;
+		std::vector<std::pair<InternedString, int>> members;
+		uint64_t fingerprint = 0; //hash of the name, type and all name value pairs
+
+		void updateFingerprint()
+		{
+			Fingerprint fp;
+			addToFingerprint(fp);
+			fingerprint = fp.get();
+		}
+
+		void addToFingerprint(Fingerprint& fp) const
+		{
+			fp.add(std::string_view(cppName.str()));
+			fp.add(std::string_view(type));
+			fp.add(static_cast<int64_t>(size));
+			fp.add(static_cast<int64_t>(members.size()));
+			for (const auto& [name, value] : members)
+			{
+				fp.add(std::string_view(name.str()));
+				fp.add(static_cast<int64_t>(value));
+			}
+		}
 
 		nlohmann::json toJson() const
 		{
@@ -435,6 +834,7 @@ namespace EngineStructs
 			j["c"] = cppName;
 			j["t"] = type;
 			j["sz"] = size;
+			j["fp"] = fingerprint;
 			nlohmann::json jMembers;
 			for (const auto& member : members)
 			{
@@ -481,6 +881,24 @@ namespace EngineStructs
 		std::vector<Struct> classes;
 		std::vector<Enum> enums;
 		std::vector<Function*> functions; //pointer because these functions reside in classes and structs and are even ordered
+		uint64_t fingerprint = 0; //hash of the fingerprints of all structs, classes and enums
+
+		//call after the fingerprints of the structs, classes and enums got updated
+		void updateFingerprint()
+		{
+			Fingerprint fp;
+			fp.add(std::string_view(packageName));
+			for (const auto* list : { &structs, &classes })
+			{
+				fp.add(static_cast<int64_t>(list->size()));
+				for (const auto& struc : *list)
+					fp.add(static_cast<int64_t>(struc.fingerprint));
+			}
+			fp.add(static_cast<int64_t>(enums.size()));
+			for (const auto& enu : enums)
+				fp.add(static_cast<int64_t>(enu.fingerprint));
+			fingerprint = fp.get();
+		}
 
 		static bool packageCompare(const Package& a, const Package& b) {
 			if (a.packageName == "BasicType")
@@ -512,6 +930,7 @@ namespace EngineStructs
 			nlohmann::json j;
 			j["p"] = packageName;
 			j["i"] = index;
+			j["fp"] = fingerprint;
 
 			nlohmann::json jStructs;
 			for (const auto& struc : structs)
@@ -545,4 +964,29 @@ namespace EngineStructs
 			return p;
 		}
 	};
+
+	/**
+	 * \brief One place where a type is used. Gets collected in finishPackages, see EngineCore::getReferencesOfSymbol
+	 */
+	struct TypeReference
+	{
+		enum ReferenceKind
+		{
+			RK_Member, //owner has the type as member, index is the definedMembers index
+			RK_Parameter, //function takes the type, index is the params index
+			RK_ReturnType, //function returns the type
+			RK_Subclass //owner inherits the type
+		};
+
+		ReferenceKind kind = RK_Member;
+		Struct* owner = nullptr; //struct that has the member, the subclass or the struct of the function
+		Function* function = nullptr; //only for RK_Parameter and RK_ReturnType
+		int index = 0;
+		bool bSubtype = false; //type is not used directly but as subtype, e.g. TArray<type>
+
+		Member* getMember() const
+		{
+			return kind == RK_Member ? &owner->definedMembers[index] : nullptr;
+		}
+	};
 };
\ No newline at end of file
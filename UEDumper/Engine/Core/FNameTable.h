@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include <string_view>
+#include <functional>
+
+
+/****************************************************
+*													*
+*	FNameTable.h Dense table of all cached FNames.	*
+*	The ComparisonIndex is split into block and		*
+*	offset like in the games FNamePool, every name	*
+*	points into one big string arena.				*
+*													*
+****************************************************/
+
+//size of one chunk of the string arena. Has to be bigger than the longest name
+#define FNAMETABLE_ARENA_CHUNK_SIZE (1024 * 1024)
+
+/**
+ * \brief Insert only table that maps a FName ComparisonIndex to its string.
+ * Lookups are lock free, inserts lock the table. Strings never move, so the returned string_views stay valid until clear() gets called.
+ */
+class FNameTable
+{
+	//the index is split like the FNamePool does it, the upper bits are the block and the lower 16 bits the offset.
+	//The offsets of a block are split again into groups of 64. Names in the pool are at least 2 offsets apart,
+	//so a group only stores the offsets that really have a name instead of 64 slots
+	static constexpr int BlockBits = 16;
+	static constexpr int GroupBits = 6;
+	static constexpr size_t NumBlocks = 0x8000;
+	static constexpr size_t GroupsPerBlock = 1 << (BlockBits - GroupBits);
+	static constexpr uint32_t FirstGroupCapacity = 8;
+
+	//offsets and arena positions of the names in a group. Entries are only appended, readers see everything below count.
+	//If the group is full it gets copied into a bigger one, the old one stays alive until clear()
+	struct Group
+	{
+		std::atomic<uint32_t> count;
+		uint32_t capacity;
+
+		uint8_t* offsets()
+		{
+			return reinterpret_cast<uint8_t*>(positions() + capacity);
+		}
+
+		uint32_t* positions()
+		{
+			return reinterpret_cast<uint32_t*>(this + 1);
+		}
+
+		static Group* create(uint32_t capacity)
+		{
+			const auto group = static_cast<Group*>(malloc(sizeof(Group) + capacity * (sizeof(uint32_t) + sizeof(uint8_t))));
+			group->count.store(0, std::memory_order_relaxed);
+			group->capacity = capacity;
+			return group;
+		}
+	};
+
+	struct Block
+	{
+		std::atomic<Group*> groups[GroupsPerBlock];
+	};
+
+	std::atomic<Block*> blocks[NumBlocks]{};
+
+	//every name is stored as uint32_t length followed by the characters and a null terminator
+	std::vector<char*> arenaChunks{};
+	std::atomic<char**> arenaChunkTable = nullptr;
+	size_t arenaChunkTableSize = 0;
+	uint32_t arenaCursor = 0;
+
+	//groups and chunk tables that got replaced. Readers might still use them, so they are only freed in clear()
+	std::vector<void*> retired{};
+	std::vector<char**> retiredChunkTables{};
+
+	std::atomic<size_t> count = 0;
+	std::mutex writeMutex;
+
+	static bool splitIndex(int index, size_t& block, size_t& group, uint8_t& offset)
+	{
+		if (index < 0)
+			return false;
+		const auto uIndex = static_cast<uint32_t>(index);
+		block = uIndex >> BlockBits;
+		group = uIndex >> GroupBits & (GroupsPerBlock - 1);
+		offset = static_cast<uint8_t>(uIndex & ((1 << GroupBits) - 1));
+		return block < NumBlocks;
+	}
+
+	static int findInGroup(Group* group, uint32_t entries, uint8_t offset)
+	{
+		const auto found = static_cast<const uint8_t*>(memchr(group->offsets(), offset, entries));
+		return found ? static_cast<int>(found - group->offsets()) : -1;
+	}
+
+	std::string_view fromArena(uint32_t position) const
+	{
+		const char* const* chunkTable = arenaChunkTable.load(std::memory_order_acquire);
+		const char* data = chunkTable[position / FNAMETABLE_ARENA_CHUNK_SIZE] + position % FNAMETABLE_ARENA_CHUNK_SIZE;
+		return { data + sizeof(uint32_t), *reinterpret_cast<const uint32_t*>(data) };
+	}
+
+	//writer lock must be held
+	uint32_t addToArena(std::string_view name)
+	{
+		const uint32_t bytes = static_cast<uint32_t>((sizeof(uint32_t) + name.size() + 1 + 3) & ~static_cast<size_t>(3));
+		if (arenaChunks.empty() || arenaCursor % FNAMETABLE_ARENA_CHUNK_SIZE == 0 || arenaCursor % FNAMETABLE_ARENA_CHUNK_SIZE + bytes > FNAMETABLE_ARENA_CHUNK_SIZE)
+		{
+			arenaChunks.push_back(static_cast<char*>(malloc(FNAMETABLE_ARENA_CHUNK_SIZE)));
+			arenaCursor = static_cast<uint32_t>((arenaChunks.size() - 1) * FNAMETABLE_ARENA_CHUNK_SIZE);
+
+			if (arenaChunks.size() > arenaChunkTableSize)
+			{
+				arenaChunkTableSize = arenaChunkTableSize ? arenaChunkTableSize * 2 : 64;
+				const auto newTable = new char* [arenaChunkTableSize] {};
+				memcpy(newTable, arenaChunks.data(), (arenaChunks.size() - 1) * sizeof(char*));
+				if (const auto oldTable = arenaChunkTable.load(std::memory_order_relaxed))
+					retiredChunkTables.push_back(oldTable);
+				arenaChunkTable.store(newTable, std::memory_order_release);
+			}
+			arenaChunkTable.load(std::memory_order_relaxed)[arenaChunks.size() - 1] = arenaChunks.back();
+		}
+
+		char* data = arenaChunks.back() + arenaCursor % FNAMETABLE_ARENA_CHUNK_SIZE;
+		*reinterpret_cast<uint32_t*>(data) = static_cast<uint32_t>(name.size());
+		memcpy(data + sizeof(uint32_t), name.data(), name.size());
+		data[sizeof(uint32_t) + name.size()] = 0;
+
+		const uint32_t position = arenaCursor;
+		arenaCursor += bytes;
+		return position;
+	}
+
+public:
+
+	FNameTable() = default;
+	FNameTable(const FNameTable&) = delete;
+	FNameTable& operator=(const FNameTable&) = delete;
+
+	~FNameTable()
+	{
+		clear();
+	}
+
+	/**
+	 * \brief lock free lookup
+	 * \param index ComparisonIndex of the name
+	 * \return view of the cached name. data() is nullptr if the name is not cached, cached names are always null terminated
+	 */
+	std::string_view find(int index) const
+	{
+		size_t block, group;
+		uint8_t offset;
+		if (!splitIndex(index, block, group, offset))
+			return {};
+		const Block* blockPtr = blocks[block].load(std::memory_order_acquire);
+		if (!blockPtr)
+			return {};
+		Group* groupPtr = blockPtr->groups[group].load(std::memory_order_acquire);
+		if (!groupPtr)
+			return {};
+		const int entry = findInGroup(groupPtr, groupPtr->count.load(std::memory_order_acquire), offset);
+		if (entry < 0)
+			return {};
+		return fromArena(groupPtr->positions()[entry]);
+	}
+
+	bool contains(int index) const
+	{
+		return find(index).data() != nullptr;
+	}
+
+	/**
+	 * \brief inserts the name if the index is not cached yet
+	 * \param index ComparisonIndex of the name
+	 * \param name the name
+	 * \return view of the cached name (the already existing one if the index was inserted before)
+	 */
+	std::string_view insert(int index, std::string_view name)
+	{
+		size_t block, group;
+		uint8_t offset;
+		if (!splitIndex(index, block, group, offset) || name.size() + sizeof(uint32_t) + 4 > FNAMETABLE_ARENA_CHUNK_SIZE)
+			return {};
+
+		std::lock_guard lock(writeMutex);
+
+		Block* blockPtr = blocks[block].load(std::memory_order_relaxed);
+		if (!blockPtr)
+		{
+			blockPtr = new Block{};
+			blocks[block].store(blockPtr, std::memory_order_release);
+		}
+
+		Group* groupPtr = blockPtr->groups[group].load(std::memory_order_relaxed);
+		if (!groupPtr)
+		{
+			groupPtr = Group::create(FirstGroupCapacity);
+			blockPtr->groups[group].store(groupPtr, std::memory_order_release);
+		}
+
+		const uint32_t entries = groupPtr->count.load(std::memory_order_relaxed);
+		if (const int existing = findInGroup(groupPtr, entries, offset); existing >= 0)
+			return fromArena(groupPtr->positions()[existing]);
+
+		if (entries == groupPtr->capacity)
+		{
+			Group* newGroup = Group::create(groupPtr->capacity * 2);
+			memcpy(newGroup->positions(), groupPtr->positions(), entries * sizeof(uint32_t));
+			memcpy(newGroup->offsets(), groupPtr->offsets(), entries * sizeof(uint8_t));
+			newGroup->count.store(entries, std::memory_order_relaxed);
+			blockPtr->groups[group].store(newGroup, std::memory_order_release);
+			retired.push_back(groupPtr);
+			groupPtr = newGroup;
+		}
+
+		const uint32_t position = addToArena(name);
+		groupPtr->positions()[entries] = position;
+		groupPtr->offsets()[entries] = offset;
+		groupPtr->count.store(entries + 1, std::memory_order_release);
+
+		count.fetch_add(1, std::memory_order_relaxed);
+		return fromArena(position);
+	}
+
+	size_t size() const
+	{
+		return count.load(std::memory_order_relaxed);
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	/**
+	 * \brief calls the function for every cached name in ascending index order
+	 * \param func function taking the index and the name
+	 */
+	void forEach(const std::function<void(int, std::string_view)>& func) const
+	{
+		std::vector<std::pair<uint8_t, uint32_t>> groupEntries;
+		for (size_t block = 0; block < NumBlocks; block++)
+		{
+			const Block* blockPtr = blocks[block].load(std::memory_order_acquire);
+			if (!blockPtr)
+				continue;
+			for (size_t group = 0; group < GroupsPerBlock; group++)
+			{
+				Group* groupPtr = blockPtr->groups[group].load(std::memory_order_acquire);
+				if (!groupPtr)
+					continue;
+				const uint32_t entries = groupPtr->count.load(std::memory_order_acquire);
+				groupEntries.clear();
+				for (uint32_t i = 0; i < entries; i++)
+					groupEntries.emplace_back(groupPtr->offsets()[i], groupPtr->positions()[i]);
+				std::sort(groupEntries.begin(), groupEntries.end());
+
+				for (const auto& [offset, position] : groupEntries)
+					func(static_cast<int>(block << BlockBits | group << GroupBits | offset), fromArena(position));
+			}
+		}
+	}
+
+	/**
+	 * \brief removes all names. NOT safe while other threads read the table, all returned views get invalid.
+	 */
+	void clear()
+	{
+		std::lock_guard lock(writeMutex);
+		for (auto& block : blocks)
+		{
+			Block* blockPtr = block.exchange(nullptr);
+			if (!blockPtr)
+				continue;
+			for (auto& group : blockPtr->groups)
+				free(group.load(std::memory_order_relaxed));
+			delete blockPtr;
+		}
+		for (const auto group : retired)
+			free(group);
+		retired.clear();
+
+		for (const auto chunk : arenaChunks)
+			free(chunk);
+		arenaChunks.clear();
+		delete[] arenaChunkTable.exchange(nullptr);
+		for (const auto table : retiredChunkTables)
+			delete[] table;
+		retiredChunkTables.clear();
+		arenaChunkTableSize = 0;
+		arenaCursor = 0;
+		count.store(0, std::memory_order_relaxed);
+	}
+};
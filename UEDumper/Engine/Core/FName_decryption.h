@@ -72,4 +72,17 @@ static void fname_decrypt(char* inputBuf, int namelength)
 
 	//memcpy here if needed, also inputBuf should have the same size as decname otherwise buffer overflow
 	//memcpy(inputBuf, decname, sizeof(decname));
-}
\ No newline at end of file
+}
+
+/*
+ * Batched version of fname_decrypt. The name table loader splits the names across threads
+ * and calls this with every slice, so it has to be thread safe.
+ * If your decryption can work on many names at once (e.g vectorized), implement it here.
+ * names[i] is a buffer of lengths[i] characters, decrypt it in place like in fname_decrypt.
+ * By default this just calls fname_decrypt for every name.
+*/
+static void fname_decrypt_batch(char** names, const int* lengths, int count)
+{
+	for (int i = 0; i < count; i++)
+		fname_decrypt(names[i], lengths[i]);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+
+/****************************************************
+*													*
+*	Fingerprint.h 64 bit FNV-1a hash of a layout.	*
+*	Only hash what is the same in every run (names,	*
+*	sizes, offsets), never pointers or string pool	*
+*	handles, so two dumps can be compared.			*
+*													*
+****************************************************/
+
+/**
+ * \brief Builds a fingerprint step by step. Equal inputs in the same order give the same value on every run and machine
+ */
+class Fingerprint
+{
+	uint64_t hash = 0xCBF29CE484222325;
+
+public:
+
+	void add(const void* data, size_t size)
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= static_cast<const uint8_t*>(data)[i];
+			hash *= 0x100000001B3;
+		}
+	}
+
+	void add(int64_t value)
+	{
+		add(&value, sizeof(value));
+	}
+
+	void add(std::string_view str)
+	{
+		//the length keeps "ab" + "c" apart from "a" + "bc"
+		add(static_cast<int64_t>(str.size()));
+		add(str.data(), str.size());
+	}
+
+	uint64_t get() const
+	{
+		return hash;
+	}
+};
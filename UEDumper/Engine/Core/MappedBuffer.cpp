@@ -0,0 +1,108 @@
+#include "MappedBuffer.h"
+
+#include <winioctl.h>
+
+#include "Frontend/Windows/LogWindow.h"
+
+MappedBuffer::~MappedBuffer()
+{
+	release();
+}
+
+bool MappedBuffer::create(size_t bytes, const std::string& name)
+{
+	release();
+
+	if (bytes == 0)
+		return false;
+
+	const auto path = std::filesystem::temp_directory_path() / ("UEDumper_" + std::to_string(GetCurrentProcessId()) + "_" + name + ".tmp");
+
+	//the file gets deleted by windows once the last handle is closed, even if we crash
+	file = CreateFileW(path.wstring().c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "MAPPEDBUFFER", "Could not create temp file %s (error %d)", path.string().c_str(), GetLastError());
+		return false;
+	}
+
+	//sparse files only take disk space for pages that actually got written
+	DWORD bytesReturned = 0;
+	if (!DeviceIoControl(file, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &bytesReturned, nullptr))
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "MAPPEDBUFFER", "Could not make %s sparse, the full size gets allocated on disk", path.string().c_str());
+
+	mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<uint64_t>(bytes) >> 32), static_cast<DWORD>(bytes & 0xFFFFFFFF), nullptr);
+	if (!mapping)
+	{
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "MAPPEDBUFFER", "Could not create file mapping with 0x%llX bytes (error %d)", bytes, GetLastError());
+		release();
+		return false;
+	}
+
+	view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+	if (!view)
+	{
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "MAPPEDBUFFER", "Could not map view with 0x%llX bytes (error %d)", bytes, GetLastError());
+		release();
+		return false;
+	}
+
+	size = bytes;
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "MAPPEDBUFFER", "Mapped 0x%llX bytes for %s at 0x%p", bytes, name.c_str(), view);
+	return true;
+}
+
+void MappedBuffer::release()
+{
+	if (view)
+		UnmapViewOfFile(view);
+	if (mapping)
+		CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+
+	view = nullptr;
+	mapping = nullptr;
+	file = INVALID_HANDLE_VALUE;
+	size = 0;
+}
+
+void* MappedBuffer::data() const
+{
+	return view;
+}
+
+size_t MappedBuffer::getSize() const
+{
+	return size;
+}
+
+bool MappedBuffer::valid() const
+{
+	return view != nullptr;
+}
+
+void MappedBuffer::adviseSequential(size_t offset, size_t length) const
+{
+	if (!view || offset >= size)
+		return;
+	if (offset + length > size)
+		length = size - offset;
+
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = static_cast<char*>(view) + offset;
+	range.NumberOfBytes = length;
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+void MappedBuffer::adviseCold(size_t offset, size_t length) const
+{
+	if (!view || offset >= size)
+		return;
+	if (offset + length > size)
+		length = size - offset;
+
+	//unlocking pages that are not locked removes them from the working set, they stay in the file
+	VirtualUnlock(static_cast<char*>(view) + offset, length);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "stdafx.h"
+
+
+/****************************************************
+*													*
+*	MappedBuffer.h Large zeroed buffer that lives	*
+*	in a sparse temp file mapped into memory.		*
+*	Cold pages can be paged out to the file by the	*
+*	OS instead of taking up ram.					*
+*													*
+****************************************************/
+
+class MappedBuffer
+{
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+	void* view = nullptr;
+	size_t size = 0;
+
+public:
+
+	MappedBuffer() = default;
+	MappedBuffer(const MappedBuffer&) = delete;
+	MappedBuffer& operator=(const MappedBuffer&) = delete;
+
+	~MappedBuffer();
+
+	/**
+	 * \brief creates a sparse temp file (deleted on close) of the given size and maps it. The memory is zeroed like calloc.
+	 * \param bytes size of the buffer
+	 * \param name name of the buffer, used for the temp file name
+	 * \return whether the buffer could be created
+	 */
+	bool create(size_t bytes, const std::string& name);
+
+	/**
+	 * \brief unmaps the view and deletes the temp file
+	 */
+	void release();
+
+	void* data() const;
+
+	size_t getSize() const;
+
+	bool valid() const;
+
+	/**
+	 * \brief hint that the range gets accessed sequentially soon, the OS reads the pages in ahead of time
+	 * \param offset offset in the buffer
+	 * \param length length of the range
+	 */
+	void adviseSequential(size_t offset, size_t length) const;
+
+	/**
+	 * \brief hint that the range wont be needed for a while, the pages get removed from our working set
+	 * \param offset offset in the buffer
+	 * \param length length of the range
+	 */
+	void adviseCold(size_t offset, size_t length) const;
+};
@@ -5,6 +5,21 @@
 #include "Frontend/Windows/LogWindow.h"
 #include "Memory/memory.h"
 
+#if UE_VERSION == UE_4_20
+constexpr auto numElementsPerChunk = 65 * 1024;
+#else
+constexpr auto numElementsPerChunk = 64 * 1024;
+#endif
+
+//slots of the runtime cache this thread got and didnt release yet
+static thread_local std::vector<size_t> heldRuntimeSlots;
+
+//current time in ms, used for the staleness checks of the runtime cache
+static int64_t getTickMs()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 void ObjectsManager::verifyUBigObjectSize(UObjectManager::UBigObject* bigObjectPtr, int requiredSize)
 {
 	if (requiredSize > UOBJECT_MAX_SIZE)
@@ -17,17 +32,213 @@ void ObjectsManager::verifyUBigObjectSize(UObjectManager::UBigObject* bigObjectP
 	}
 
 	//do we have to read more than we did at one point before?
-	if (bigObjectPtr->readSize < requiredSize)
+	if (bigObjectPtr->readSize.load(std::memory_order_acquire) < requiredSize)
 	{
 		//the real uobject ptr is actually at the buffer base where normally the vtable is
-		void* UObjectGamePtr = *reinterpret_cast<void**>(bigObjectPtr->object);
-		//and now read the object again but at the required size
-		Memory::read(UObjectGamePtr, &bigObjectPtr->object, requiredSize);
-		//overwrite vtable again with the pointer
-		*reinterpret_cast<void**>(bigObjectPtr->object) = UObjectGamePtr;
-		//new readsize
-		bigObjectPtr->readSize = requiredSize;
+		const uint64_t UObjectGamePtr = *reinterpret_cast<uint64_t*>(bigObjectPtr->object);
+
+		//other threads may read the same object right now, only one of them grows it
+		std::lock_guard lock(gUObjectManager.growLocks[(UObjectGamePtr >> 4) % std::size(gUObjectManager.growLocks)]);
+		if (bigObjectPtr->readSize.load(std::memory_order_acquire) >= requiredSize)
+			return;
+
+		//read into a temp buffer first, readers must never see the vtable at object + 0
+		char buffer[UOBJECT_MAX_SIZE];
+		Memory::read(reinterpret_cast<void*>(UObjectGamePtr), buffer, requiredSize);
+		memcpy(bigObjectPtr->object + sizeof(uint64_t), buffer + sizeof(uint64_t), requiredSize - sizeof(uint64_t));
+		//publish the bytes with the new readsize
+		bigObjectPtr->readSize.store(requiredSize, std::memory_order_release);
+	}
+}
+
+size_t ObjectsManager::cacheOverflowObjects(const std::vector<uint64_t>& gamePtrs)
+{
+	constexpr size_t objectsPerBlock = 4096;
+
+	std::lock_guard lock(gUObjectManager.overflowMutex);
+
+	std::vector<uint64_t> newPtrs;
+	std::unordered_set<uint64_t> batchPtrs;
+	for (const auto gamePtr : gamePtrs)
+	{
+		if (!gamePtr || gUObjectManager.linkedUObjectPtrs.contains(gamePtr) || !batchPtrs.insert(gamePtr).second)
+			continue;
+		newPtrs.push_back(gamePtr);
+	}
+	if (newPtrs.empty())
+		return 0;
+
+	std::vector<UObject> objects(newPtrs.size());
+	std::vector<Memory::ScatterEntry> entries(newPtrs.size());
+	for (size_t i = 0; i < newPtrs.size(); i++)
+		entries[i] = { reinterpret_cast<void*>(newPtrs[i]), &objects[i], sizeof(UObject) };
+	Memory::readScatter(entries);
+
+	//a pointer is only a object if the game has it in its object array, under its own InternalIndex.
+	//Objects created after our copy are there as well, garbage pointers are not
+	constexpr size_t itemSize = sizeof(FUObjectItem) < FUOBJECTITEM_SIZE ? sizeof(FUObjectItem) : FUOBJECTITEM_SIZE;
+	std::vector<FUObjectItem> items(newPtrs.size());
+	entries.clear();
+	for (size_t i = 0; i < newPtrs.size(); i++)
+	{
+		if (const uint64_t itemAddress = getFUObjectItemAddress(objects[i].InternalIndex))
+			entries.push_back({ reinterpret_cast<void*>(itemAddress), &items[i], itemSize });
+	}
+	Memory::readScatter(entries);
+
+	size_t cachedObjects = 0;
+	for (size_t i = 0; i < newPtrs.size(); i++)
+	{
+		const uint64_t gamePtr = newPtrs[i];
+		if (items[i].Object != gamePtr)
+			continue;
+
+		const size_t blockIndex = gUObjectManager.overflowCount / objectsPerBlock;
+		if (blockIndex >= gUObjectManager.overflowBlocks.size())
+		{
+			const auto block = static_cast<UObjectManager::UBigObject*>(calloc(objectsPerBlock, sizeof(UObjectManager::UBigObject)));
+			if (!block)
+			{
+				windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "OBJECTSMANAGER", "Failed to allocate memory for the overflow objects!");
+				errorReason = windows::LogWindow::getLastLogMessage();
+				STOP_OPERATION();
+				return cachedObjects;
+			}
+			gUObjectManager.overflowBlocks.push_back(block);
+		}
+		UObjectManager::UBigObject* bigObject = &gUObjectManager.overflowBlocks[blockIndex][gUObjectManager.overflowCount % objectsPerBlock];
+		gUObjectManager.overflowCount++;
+
+		memcpy(bigObject->object, &objects[i], sizeof(UObject));
+		*reinterpret_cast<uint64_t*>(bigObject->object) = gamePtr;
+		bigObject->readSize = sizeof(UObject);
+		bigObject->valid = true;
+		gUObjectManager.linkedUObjectPtrs.insert(gamePtr, bigObject);
+		cachedObjects++;
+	}
+	return cachedObjects;
+}
+
+void ObjectsManager::prefetchReferencedObjects()
+{
+	std::unordered_set<uint64_t> seen;
+	size_t overflowObjects = 0;
+	int rounds = 0;
+
+	//first the class and outer closure. Classes are read at full size because IsA walks their supers
+	std::vector<uint64_t> level;
+	for (int32_t i = 0; i < gUObjectManager.UObjectArray.NumElements; i++)
+	{
+		const uint64_t gamePtr = *reinterpret_cast<uint64_t*>(gUObjectManager.pGObjectPtrArray + static_cast<uint64_t>(i) * FUOBJECTITEM_SIZE);
+		if (gamePtr && seen.insert(gamePtr).second)
+			level.push_back(gamePtr);
+	}
+
+	std::unordered_set<uint64_t> classes;
+	while (!level.empty())
+	{
+		if (CRITICAL_STOP_CALLED())
+			return;
+
+		overflowObjects += cacheOverflowObjects(level);
+
+		std::vector<uint64_t> classTargets;
+		std::vector<uint64_t> nextLevel;
+		auto addTarget = [&](uint64_t target)
+		{
+			if (target && seen.insert(target).second)
+				nextLevel.push_back(target);
+		};
+		for (const auto gamePtr : level)
+		{
+			const auto linkedObject = gUObjectManager.linkedUObjectPtrs.find(gamePtr);
+			if (!linkedObject)
+				continue;
+			const auto object = reinterpret_cast<UObject*>((*linkedObject)->object);
+			const auto classPtr = reinterpret_cast<uint64_t>(object->ClassPrivate);
+			if (classPtr && classes.insert(classPtr).second)
+				classTargets.push_back(classPtr);
+			addTarget(classPtr);
+			addTarget(reinterpret_cast<uint64_t>(object->OuterPrivate));
+		}
+
+		//classes have to be in the cache before we can grow them
+		overflowObjects += cacheOverflowObjects(classTargets);
+		growUObjects(classTargets, sizeof(UClass));
+		for (const auto classPtr : classTargets)
+		{
+			const auto linkedObject = gUObjectManager.linkedUObjectPtrs.find(classPtr);
+			if (!linkedObject)
+				continue;
+			const auto superPtr = reinterpret_cast<uint64_t>(reinterpret_cast<UClass*>((*linkedObject)->object)->SuperStruct);
+			//supers of classes are classes again
+			if (superPtr && classes.insert(superPtr).second)
+			{
+				seen.insert(superPtr);
+				nextLevel.push_back(superPtr);
+			}
+		}
+		level.swap(nextLevel);
+		rounds++;
 	}
+
+	//now every class is complete, so IsA works. Read all structs and their supers at their real size
+	std::vector<uint64_t> structs;
+	std::vector<uint64_t> classObjects;
+	std::vector<uint64_t> functions;
+	std::unordered_set<uint64_t> structsSeen;
+	auto sortStruct = [&](uint64_t gamePtr)
+	{
+		const auto object = getUObject<UObject>(gamePtr);
+		if (!object || !object->IsA<UStruct>() || !structsSeen.insert(gamePtr).second)
+			return false;
+		if (object->IsA<UClass>())
+			classObjects.push_back(gamePtr);
+		else if (object->IsA<UFunction>())
+			functions.push_back(gamePtr);
+		else
+			structs.push_back(gamePtr);
+		return true;
+	};
+	for (int32_t i = 0; i < gUObjectManager.UObjectArray.NumElements; i++)
+	{
+		if (CRITICAL_STOP_CALLED())
+			return;
+		const uint64_t gamePtr = *reinterpret_cast<uint64_t*>(gUObjectManager.pGObjectPtrArray + static_cast<uint64_t>(i) * FUOBJECTITEM_SIZE);
+		if (gamePtr)
+			sortStruct(gamePtr);
+	}
+
+	while (!structs.empty() || !classObjects.empty() || !functions.empty())
+	{
+		if (CRITICAL_STOP_CALLED())
+			return;
+
+		growUObjects(classObjects, sizeof(UClass));
+		growUObjects(functions, sizeof(UFunction));
+		growUObjects(structs, sizeof(UStruct));
+
+		std::vector<uint64_t> supers;
+		for (const auto vec : { &structs, &classObjects, &functions })
+		{
+			for (const auto gamePtr : *vec)
+			{
+				if (const auto struc = getUObject<UStruct>(gamePtr); struc && struc->SuperStruct)
+					supers.push_back(reinterpret_cast<uint64_t>(struc->SuperStruct));
+			}
+		}
+		structs.clear();
+		classObjects.clear();
+		functions.clear();
+
+		overflowObjects += cacheOverflowObjects(supers);
+		for (const auto superPtr : supers)
+			sortStruct(superPtr);
+		rounds++;
+	}
+
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "OBJECTSMANAGER",
+		"Prefetched referenced objects in %d rounds (%llu classes, %llu structs, %llu objects outside of GObjects)", rounds, classes.size(), structsSeen.size(), overflowObjects);
 }
 
 uint64_t ObjectsManager::getUObjectPtrByIndex(int index)
@@ -42,7 +253,7 @@ uint64_t ObjectsManager::getUObjectPtrByIndex(int index)
 		return 0;
 	}
 
-	return *reinterpret_cast<uint64_t*>(gUObjectManager.pGObjectPtrArray + (index * FUOBJECTITEM_SIZE));
+	return *reinterpret_cast<uint64_t*>(gUObjectManager.pGObjectPtrArray + (static_cast<uint64_t>(index) * FUOBJECTITEM_SIZE));
 }
 
 void ObjectsManager::STOP_OPERATION()
@@ -67,11 +278,8 @@ ObjectsManager::ObjectsManager()
 		return;
 	}
 
-	gUObjectManager.UObjectArray = Memory::read<TypeUObjectArray>(UObjectAddr);
-
-#if GOBJECTS_XOR_ECRYPTION_KEY
-	gUObjectManager.UObjectArray.Objects = reinterpret_cast<FUObjectItem**>((decryptPointer(reinterpret_cast<uint64_t>(gUObjectManager.UObjectArray.Objects))));
-#endif
+	gUObjectManager.UObjectArrayAddress = UObjectAddr;
+	readLiveObjectArray(gUObjectManager.UObjectArray);
 
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "OBJECTSMANAGER", "TUObject -> 0x%p", gUObjectManager.UObjectArray.Objects);
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "OBJECTSMANAGER", "TUObject elements: %d", gUObjectManager.UObjectArray.NumElements);
@@ -84,7 +292,7 @@ ObjectsManager::ObjectsManager()
 		return;
 	}
 
-	if (gUObjectManager.UObjectArray.NumElements < 100 || gUObjectManager.UObjectArray.NumElements > 50000000)
+	if (gUObjectManager.UObjectArray.NumElements < 100 || gUObjectManager.UObjectArray.NumElements > MAX_OBJECT_ELEMENTS)
 	{
 		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "OBJECTSMANAGER", "TUobject elements are invalid!");
 		errorReason = "TUobject elements are invalid! This means the OFFSET_GOBJECTS offset is wrong. The log below shows how many elements the dumper found.";
@@ -123,7 +331,12 @@ ObjectsManager::ObjectsManager()
 
 bool ObjectsManager::CRITICAL_STOP_CALLED()
 {
-	return _STOP_OPERATION;
+	return _STOP_OPERATION || dumpCancellation.isCancelled();
+}
+
+CancellationToken& ObjectsManager::getCancellationToken()
+{
+	return dumpCancellation;
 }
 
 void ObjectsManager::resolvedStop()
@@ -140,10 +353,9 @@ void ObjectsManager::copyGObjectPtrs(int64_t& finishedBytes, int64_t& totalBytes
 {
 	status = CS_busy;
 	finishedBytes = 0;
-	totalBytes = gUObjectManager.UObjectArray.NumElements * FUOBJECTITEM_SIZE;
-	gUObjectManager.pGObjectPtrArray = reinterpret_cast<uint64_t>(calloc(1, totalBytes));
-	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "OBJECTSMANAGER", "Allocating 0x%p bytes of memory for GObjectPtrArray at 0x%p", totalBytes, gUObjectManager.pGObjectPtrArray);
-	if (!gUObjectManager.pGObjectPtrArray)
+	totalBytes = static_cast<int64_t>(gUObjectManager.UObjectArray.NumElements) * FUOBJECTITEM_SIZE;
+
+	if (!allocateGObjectPtrArray(totalBytes))
 	{
 		status = CS_error;
 		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "OBJECTSMANAGER", "Failed to allocate memory for GObjectPtrArray!");
@@ -153,59 +365,77 @@ void ObjectsManager::copyGObjectPtrs(int64_t& finishedBytes, int64_t& totalBytes
 	}
 
 #if UE_VERSION < UE_4_20
-	//no chunks
+	//no chunks, the whole array is one read
 	const uint64_t objectArrayStart = reinterpret_cast<uint64_t>(gUObjectManager.UObjectArray.Objects);
-
-	while (finishedBytes + 0x100 < totalBytes)
-	{
-		Memory::read(reinterpret_cast<void*>(objectArrayStart + finishedBytes), reinterpret_cast<void*>(gUObjectManager.pGObjectPtrArray + finishedBytes), 0x100);
-		finishedBytes += 0x100;
-	}
-	const auto reminingBytes = totalBytes - finishedBytes;
-	Memory::read(reinterpret_cast<void*>(objectArrayStart + finishedBytes), reinterpret_cast<void*>(gUObjectManager.pGObjectPtrArray + finishedBytes), reminingBytes);
-	finishedBytes += reminingBytes;
+	Memory::read(reinterpret_cast<void*>(objectArrayStart), reinterpret_cast<void*>(gUObjectManager.pGObjectPtrArray), totalBytes);
+	finishedBytes = totalBytes;
 
 #else
 	//chunks apperared
-#if UE_VERSION == UE_4_20
-	constexpr auto numElementsPerChunk = 65 * 1024;
-#else
-	constexpr auto numElementsPerChunk = 64 * 1024;
-#endif
-
-	constexpr auto chunkBytesSize = numElementsPerChunk * FUOBJECTITEM_SIZE;
+	constexpr int64_t chunkBytesSize = static_cast<int64_t>(numElementsPerChunk) * FUOBJECTITEM_SIZE;
 
-	for (int i = 0; i < gUObjectManager.UObjectArray.NumChunks; i++)
+	for (int i = 0; i < gUObjectManager.UObjectArray.NumChunks && finishedBytes < totalBytes; i++)
 	{
 		//chunks are in objects*
 		const auto chunkStart = Memory::read<uint64_t>(reinterpret_cast<uint64_t>(gUObjectManager.UObjectArray.Objects) + (i * 0x8)) + CHUNK_PADDING;
 
-		auto chunkBytesRead = 0;
 		printf("chunk %i from %llX to %llX\n", i, chunkStart, chunkStart + chunkBytesSize);
-		//256 bytes is good enough, a full chunk would take 6144 reads.
-		//if the chunk is only half full, we got the code below. totalBytes calculates the bytes for all existing elements
-		while (finishedBytes + 0x100 < totalBytes && chunkBytesRead < chunkBytesSize)
-		{
-			Memory::read(reinterpret_cast<void*>(chunkStart + chunkBytesRead), reinterpret_cast<void*>(gUObjectManager.pGObjectPtrArray + finishedBytes), 0x100);
-			chunkBytesRead += 0x100;
-			finishedBytes += 0x100;
-		}
-		//fixup the remaining bytes, should only apply for the latest elements in chunk X
-		if (finishedBytes + 0x100 > totalBytes && totalBytes - finishedBytes > 0)
-		{
-			const auto reminingBytes = totalBytes - finishedBytes;
-			Memory::read(reinterpret_cast<void*>(chunkStart + chunkBytesRead), reinterpret_cast<void*>(gUObjectManager.pGObjectPtrArray + finishedBytes), reminingBytes);
-			finishedBytes += reminingBytes;
-		}
+		if (CRITICAL_STOP_CALLED())
+			break;
+		//one read per chunk like readFUObjectItems, the last chunk is only read up to the last existing element
+		const int64_t chunkBytes = totalBytes - finishedBytes < chunkBytesSize ? totalBytes - finishedBytes : chunkBytesSize;
+		Memory::read(reinterpret_cast<void*>(chunkStart), reinterpret_cast<void*>(gUObjectManager.pGObjectPtrArray + finishedBytes), chunkBytes);
+		finishedBytes += chunkBytes;
 	}
 
+#endif
+
+	if (CRITICAL_STOP_CALLED())
+	{
+		status = CS_error;
+		return;
+	}
+
+#if USE_DUMP_CHECKPOINTS
+	//the objects and packages checkpoints belong to this copy of the array
+	Fingerprint snapshot;
+	snapshot.add(reinterpret_cast<const void*>(gUObjectManager.pGObjectPtrArray), static_cast<size_t>(totalBytes));
+	objectSnapshotId = snapshot.get();
 #endif
 
 	status = CS_success;
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "OBJECTSMANAGER", "Loaded GObjectPtrArray successfully!");
 }
 
-void ObjectsManager::copyUBigObjects(int64_t& finishedBytes, int64_t& totalBytes, CopyStatus& status)
+bool ObjectsManager::allocateGObjectPtrArray(int64_t bytes)
+{
+	//the array of a try that failed. With mapped arrays it is only on the heap if the mapping failed
+#if USE_MAPPED_OBJECT_ARRAYS
+	if (gUObjectManager.pGObjectPtrArray && !gUObjectManager.GObjectPtrBuffer.valid())
+#else
+	if (gUObjectManager.pGObjectPtrArray)
+#endif
+		free(reinterpret_cast<void*>(gUObjectManager.pGObjectPtrArray));
+	gUObjectManager.pGObjectPtrArray = 0;
+
+#if USE_MAPPED_OBJECT_ARRAYS
+	if (gUObjectManager.GObjectPtrBuffer.create(bytes, "GObjectPtrArray"))
+	{
+		gUObjectManager.pGObjectPtrArray = reinterpret_cast<uint64_t>(gUObjectManager.GObjectPtrBuffer.data());
+		//we write the whole array from start to end
+		gUObjectManager.GObjectPtrBuffer.adviseSequential(0, bytes);
+	}
+	else
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "OBJECTSMANAGER", "Could not map GObjectPtrArray, using the heap instead");
+#endif
+	if (!gUObjectManager.pGObjectPtrArray)
+		gUObjectManager.pGObjectPtrArray = reinterpret_cast<uint64_t>(calloc(1, bytes));
+
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "OBJECTSMANAGER", "Allocating 0x%p bytes of memory for GObjectPtrArray at 0x%p", bytes, gUObjectManager.pGObjectPtrArray);
+	return gUObjectManager.pGObjectPtrArray != 0;
+}
+
+void ObjectsManager::copyUBigObjects(int64_t& finishedBytes, int64_t& totalBytes, CopyStatus& status, BoundedQueue<ObjectChunk>* copiedChunks)
 {
 	status = CS_busy;
 
@@ -214,8 +444,36 @@ void ObjectsManager::copyUBigObjects(int64_t& finishedBytes, int64_t& totalBytes
 	totalBytes = gUObjectManager.UObjectArray.NumElements * sizeof(UObject);
 	const auto allocatedBytes = gUObjectManager.UObjectArray.NumElements * sizeof(UObjectManager::UBigObject);
 	
+	//the objects of a try that failed. With mapped arrays they are only on the heap if the mapping failed
+	gUObjectManager.linkedUObjectPtrs.clear();
+	enumNamesCache.clear();
+	{
+		//the blocks get reused
+		std::lock_guard lock(gUObjectManager.overflowMutex);
+		gUObjectManager.overflowCount = 0;
+	}
+#if USE_MAPPED_OBJECT_ARRAYS
+	if (gUObjectManager.pUBigObjectArray && !gUObjectManager.UBigObjectBuffer.valid())
+#else
+	if (gUObjectManager.pUBigObjectArray)
+#endif
+		free(reinterpret_cast<void*>(gUObjectManager.pUBigObjectArray));
+	gUObjectManager.pUBigObjectArray = 0;
+
 	//allocate UOBJECT_MAX_SIZE bytes for every UObject
-	gUObjectManager.pUBigObjectArray = reinterpret_cast<uint64_t>(calloc(1, allocatedBytes));
+#if USE_MAPPED_OBJECT_ARRAYS
+	if (gUObjectManager.UBigObjectBuffer.create(allocatedBytes, "UBigObjectArray"))
+	{
+		gUObjectManager.pUBigObjectArray = reinterpret_cast<uint64_t>(gUObjectManager.UBigObjectBuffer.data());
+		//both arrays get walked once from start to end
+		gUObjectManager.UBigObjectBuffer.adviseSequential(0, allocatedBytes);
+		gUObjectManager.GObjectPtrBuffer.adviseSequential(0, gUObjectManager.GObjectPtrBuffer.getSize());
+	}
+	else
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "ENGINECORE", "Could not map UBigObjectArray, using the heap instead");
+#endif
+	if (!gUObjectManager.pUBigObjectArray)
+		gUObjectManager.pUBigObjectArray = reinterpret_cast<uint64_t>(calloc(1, allocatedBytes));
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Allocating 0x%llX bytes of memory for UBigObjectArray at 0x%p", totalBytes, gUObjectManager.pUBigObjectArray);
 
 	if (!gUObjectManager.pUBigObjectArray)
@@ -225,15 +483,36 @@ void ObjectsManager::copyUBigObjects(int64_t& finishedBytes, int64_t& totalBytes
 		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "ENGINECORE", "Failed to allocate memory for UBigObjectArray!");
 		errorReason = windows::LogWindow::getLastLogMessage();
 		STOP_OPERATION();
+		if (copiedChunks)
+			copiedChunks->close();
 		return;
 	}
 
-	//go through each element
+#if USE_DUMP_CHECKPOINTS
+	const bool bFromCheckpoint = loadObjectCheckpoint(finishedBytes);
+	bObjectsFromCheckpoint = bFromCheckpoint;
+#else
+	constexpr bool bFromCheckpoint = false;
+#endif
+
+	//the checkpoint has all objects already, the next stage still gets every chunk
+	const int32_t numElements = gUObjectManager.UObjectArray.NumElements;
+	if (bFromCheckpoint && copiedChunks)
+	{
+		for (int32_t start = 0; start < numElements; start += PIPELINE_OBJECT_CHUNK_SIZE)
+			copiedChunks->push({ start, start + PIPELINE_OBJECT_CHUNK_SIZE < numElements ? start + PIPELINE_OBJECT_CHUNK_SIZE : numElements });
+	}
+
+	//go through each element, none if they came from the checkpoint
 	int32_t numInvalidElements = 0;
-	for (int32_t i = 0; i < gUObjectManager.UObjectArray.NumElements; i++)
+	int32_t chunkStart = 0;
+	for (int32_t i = bFromCheckpoint ? numElements : 0; i < numElements; i++)
 	{
+		if (CRITICAL_STOP_CALLED())
+			break;
+
 		//get the real UObject address
-		const uint64_t UObjectAddress = *reinterpret_cast<uint64_t*>(gUObjectManager.pGObjectPtrArray + i * FUOBJECTITEM_SIZE);
+		const uint64_t UObjectAddress = *reinterpret_cast<uint64_t*>(gUObjectManager.pGObjectPtrArray + static_cast<uint64_t>(i) * FUOBJECTITEM_SIZE);
 		//this happens quite often, those objects just got deleted
 		//the array is like a block of cheese with holes
 		if (!UObjectAddress) {
@@ -258,21 +537,136 @@ void ObjectsManager::copyUBigObjects(int64_t& finishedBytes, int64_t& totalBytes
 		}
 
 		finishedBytes += sizeof(UObject);
+
+		//hand the chunk to the next stage. If it stopped early the queue is closed and we just go on
+		if (copiedChunks && (i + 1 - chunkStart == PIPELINE_OBJECT_CHUNK_SIZE || i + 1 == gUObjectManager.UObjectArray.NumElements))
+		{
+			copiedChunks->push({ chunkStart, i + 1 });
+			chunkStart = i + 1;
+		}
 	}
+	//the next stage only needs the object headers, the referenced objects below are read while it works on the chunks
+	if (copiedChunks)
+		copiedChunks->close();
 
 	if (numInvalidElements > 0)
 	{
 		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "ENGINECORE", "Failed to resolve address for %d/%d objects", numInvalidElements, gUObjectManager.UObjectArray.NumElements);
 	}
 
+#if USE_MAPPED_OBJECT_ARRAYS
+	//the pointer array is only needed for findObject from now on, let the OS page it out
+	gUObjectManager.GObjectPtrBuffer.adviseCold(0, gUObjectManager.GObjectPtrBuffer.getSize());
+#endif
+
+	//almost every object looks up its class and outer right after, get them all now.
+	//The checkpoint only has the objects of the array, the ones outside get read again
+	prefetchReferencedObjects();
+	if (CRITICAL_STOP_CALLED())
+	{
+		status = CS_error;
+		return;
+	}
+
+#if USE_DUMP_CHECKPOINTS
+	//the checkpoint gets written in its own stage, the FName caching still grows the objects
+	if (bFromCheckpoint)
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Loaded UBigObjectArray out of the checkpoint!");
+#endif
+
 	status = CS_success;
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "ENGINECORE", "Loaded UBigObjectArray successfully!");
 }
 
+bool ObjectsManager::saveObjectCheckpoint()
+{
+	if (bObjectsFromCheckpoint)
+		return true;
+
+	ObjectCheckpointHeader header;
+	header.fingerprint = EngineCore::getTargetFingerprint();
+	if (!header.fingerprint || !objectSnapshotId)
+		return false;
+	header.objectArray = reinterpret_cast<uint64_t>(gUObjectManager.UObjectArray.Objects);
+	header.numElements = gUObjectManager.UObjectArray.NumElements;
+	header.snapshotId = objectSnapshotId;
+
+	std::ofstream file(EngineCore::getCheckpointPath("UBigObjects.bin"), std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "OBJECTSMANAGER", "Could not create UBigObjects.bin!");
+		return false;
+	}
+	//the count is written once we know it
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for (int32_t i = 0; i < header.numElements; i++)
+	{
+		const auto bigObject = reinterpret_cast<UObjectManager::UBigObject*>(gUObjectManager.pUBigObjectArray + i * sizeof(UObjectManager::UBigObject));
+		if (!bigObject->valid)
+			continue;
+		const ObjectCheckpointEntry entry{ i, static_cast<uint32_t>(bigObject->readSize.load(std::memory_order_acquire)) };
+		file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+		file.write(bigObject->object, entry.readSize);
+		header.count++;
+	}
+	file.seekp(0);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	return file.good();
+}
+
+bool ObjectsManager::loadObjectCheckpoint(int64_t& finishedBytes)
+{
+	if (!objectSnapshotId)
+		return false;
+
+	std::ifstream file(EngineCore::getCheckpointPath("UBigObjects.bin"), std::ios::binary);
+	if (!file)
+		return false;
+	ObjectCheckpointHeader header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return false;
+	if (memcmp(header.magic, ObjectCheckpointHeader{}.magic, sizeof(header.magic)) != 0 || header.version != ObjectCheckpointHeader{}.version)
+		return false;
+	//objects of another pointer array
+	const int32_t numElements = gUObjectManager.UObjectArray.NumElements;
+	if (header.fingerprint != EngineCore::getTargetFingerprint() || header.snapshotId != objectSnapshotId || header.numElements != numElements)
+		return false;
+
+	for (int32_t i = 0; i < header.count; i++)
+	{
+		ObjectCheckpointEntry entry{};
+		bool bValid = file.read(reinterpret_cast<char*>(&entry), sizeof(entry)) && entry.index >= 0 && entry.index < numElements &&
+			entry.readSize >= sizeof(uint64_t) && entry.readSize <= UOBJECT_MAX_SIZE;
+		const auto bigObject = bValid ? reinterpret_cast<UObjectManager::UBigObject*>(gUObjectManager.pUBigObjectArray + entry.index * sizeof(UObjectManager::UBigObject)) : nullptr;
+		if (bValid)
+			bValid = static_cast<bool>(file.read(bigObject->object, entry.readSize));
+		if (!bValid)
+		{
+			//the copy overwrites the objects we got so far
+			windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "OBJECTSMANAGER", "UBigObjects.bin is corrupted, ignoring it");
+			gUObjectManager.linkedUObjectPtrs.clear();
+			enumNamesCache.clear();
+			finishedBytes = 0;
+			return false;
+		}
+		bigObject->readSize = entry.readSize;
+		bigObject->valid = true;
+		gUObjectManager.linkedUObjectPtrs.insert(std::pair(*reinterpret_cast<uint64_t*>(bigObject->object), bigObject));
+		finishedBytes = static_cast<int64_t>(entry.index + 1) * sizeof(UObject);
+	}
+	return true;
+}
+
 #if UE_VERSION >= UE_4_25
 
 uint64_t ObjectsManager::cacheFField(uint64_t gamePtr)
 {
+	std::lock_guard lock(gFFieldManager.cacheMutex);
+
+	//another thread might have cached it while we waited
+	if (const auto cachedField = gFFieldManager.linkedFFieldPtrs.find(gamePtr))
+		return *cachedField;
+
 	if (gFFieldManager.linkedFFieldIndexCount >= gFFieldManager.maxFFieldCacheNum)
 	{
 		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "OBJECTSMANAGER",
@@ -292,11 +686,15 @@ uint64_t ObjectsManager::cacheFField(uint64_t gamePtr)
 FFieldClass* ObjectsManager::getFFieldClass(void* gamePtr)
 {
 	auto ptr = reinterpret_cast<uint64_t>(gamePtr);
-	if (gFFieldManager.linkedFFieldClassPtrs.contains(ptr))
+	if (const auto cachedClass = gFFieldManager.linkedFFieldClassPtrs.find(ptr))
 	{
-		return reinterpret_cast<FFieldClass*>(gFFieldManager.linkedFFieldClassPtrs[ptr]);
+		return reinterpret_cast<FFieldClass*>(*cachedClass);
 	}
 	//element is not cached, go add it
+	std::lock_guard lock(gFFieldManager.cacheMutex);
+	if (const auto cachedClass = gFFieldManager.linkedFFieldClassPtrs.find(ptr))
+		return reinterpret_cast<FFieldClass*>(*cachedClass);
+
 	if (gFFieldManager.linkedFFieldClassIndexCount >= gFFieldManager.maxFFieldClassCacheNum)
 	{
 		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "OBJECTSMANAGER",
@@ -313,9 +711,610 @@ FFieldClass* ObjectsManager::getFFieldClass(void* gamePtr)
 	return reinterpret_cast<FFieldClass*>(realAddress);
 }
 
+void ObjectsManager::prefetchFFields(const std::vector<uint64_t>& gamePtrs)
+{
+	std::lock_guard lock(gFFieldManager.cacheMutex);
+
+	std::vector<Memory::ScatterEntry> entries;
+	std::vector<uint64_t> newPtrs;
+	std::unordered_set<uint64_t> batchPtrs;
+	for (const auto gamePtr : gamePtrs)
+	{
+		if (!gamePtr || gFFieldManager.linkedFFieldPtrs.contains(gamePtr) || !batchPtrs.insert(gamePtr).second)
+			continue;
+
+		if (gFFieldManager.linkedFFieldIndexCount + static_cast<int64_t>(newPtrs.size()) >= gFFieldManager.maxFFieldCacheNum)
+		{
+			windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "OBJECTSMANAGER",
+				"HARD ERROR: prefetchFFields wanted to cache another field but the cache is full! Try increasing FFIELD_CT (currently: %d)", FFIELD_CT);
+			errorReason = windows::LogWindow::getLastLogMessage();
+			STOP_OPERATION();
+			return;
+		}
+		const uint64_t realAddress = gFFieldManager.pFFieldArray + (gFFieldManager.linkedFFieldIndexCount + newPtrs.size()) * UOBJECT_MAX_SIZE;
+		entries.push_back({ reinterpret_cast<void*>(gamePtr), reinterpret_cast<void*>(realAddress), UOBJECT_MAX_SIZE });
+		newPtrs.push_back(gamePtr);
+	}
+	if (entries.empty())
+		return;
+
+	Memory::readScatter(entries);
+
+	for (size_t i = 0; i < newPtrs.size(); i++)
+	{
+		const uint64_t realAddress = reinterpret_cast<uint64_t>(entries[i].buffer);
+		*reinterpret_cast<uint64_t*>(realAddress) = newPtrs[i];
+		gFFieldManager.linkedFFieldPtrs.insert(newPtrs[i], realAddress);
+	}
+	gFFieldManager.linkedFFieldIndexCount += static_cast<int>(newPtrs.size());
+}
+
+void ObjectsManager::prefetchFFieldClasses(const std::vector<uint64_t>& gamePtrs)
+{
+	std::lock_guard lock(gFFieldManager.cacheMutex);
+
+	std::vector<Memory::ScatterEntry> entries;
+	std::vector<uint64_t> newPtrs;
+	std::unordered_set<uint64_t> batchPtrs;
+	for (const auto gamePtr : gamePtrs)
+	{
+		if (!gamePtr || gFFieldManager.linkedFFieldClassPtrs.contains(gamePtr) || !batchPtrs.insert(gamePtr).second)
+			continue;
+
+		if (gFFieldManager.linkedFFieldClassIndexCount + static_cast<int64_t>(newPtrs.size()) >= gFFieldManager.maxFFieldClassCacheNum)
+		{
+			windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "OBJECTSMANAGER",
+				"HARD ERROR: prefetchFFieldClasses wanted to cache another fieldclass but the cache is full! Try increasing FFIELD_CLASSES_CT (currently: %d)", FFIELD_CLASSES_CT);
+			errorReason = windows::LogWindow::getLastLogMessage();
+			STOP_OPERATION();
+			return;
+		}
+		const uint64_t realAddress = gFFieldManager.pFFieldClassArray + (gFFieldManager.linkedFFieldClassIndexCount + newPtrs.size()) * sizeof(FFieldClass);
+		entries.push_back({ reinterpret_cast<void*>(gamePtr), reinterpret_cast<void*>(realAddress), sizeof(FFieldClass) });
+		newPtrs.push_back(gamePtr);
+	}
+	if (entries.empty())
+		return;
+
+	Memory::readScatter(entries);
+
+	for (size_t i = 0; i < newPtrs.size(); i++)
+	{
+		const uint64_t realAddress = reinterpret_cast<uint64_t>(entries[i].buffer);
+		*reinterpret_cast<uint64_t*>(realAddress) = newPtrs[i];
+		gFFieldManager.linkedFFieldClassPtrs.insert(newPtrs[i], realAddress);
+	}
+	gFFieldManager.linkedFFieldClassIndexCount += static_cast<int>(newPtrs.size());
+}
+
+#endif
+
+void ObjectsManager::growUObjects(const std::vector<uint64_t>& gamePtrs, int requiredSize)
+{
+	if (requiredSize > UOBJECT_MAX_SIZE)
+		requiredSize = UOBJECT_MAX_SIZE;
+
+	std::vector<UObjectManager::UBigObject*> bigObjects;
+	std::unordered_set<uint64_t> batchPtrs;
+	for (const auto gamePtr : gamePtrs)
+	{
+		const auto linkedObject = gUObjectManager.linkedUObjectPtrs.find(gamePtr);
+		if (!linkedObject || (*linkedObject)->readSize.load(std::memory_order_acquire) >= requiredSize || !batchPtrs.insert(gamePtr).second)
+			continue;
+		bigObjects.push_back(*linkedObject);
+	}
+	if (bigObjects.empty())
+		return;
+
+	//read everything into a temp buffer, readers must never see the vtable at object + 0
+	std::vector<char> buffer(bigObjects.size() * requiredSize);
+	std::vector<Memory::ScatterEntry> entries(bigObjects.size());
+	for (size_t i = 0; i < bigObjects.size(); i++)
+	{
+		entries[i].address = *reinterpret_cast<void**>(bigObjects[i]->object);
+		entries[i].buffer = buffer.data() + i * requiredSize;
+		entries[i].size = requiredSize;
+	}
+	Memory::readScatter(entries);
+
+	for (size_t i = 0; i < bigObjects.size(); i++)
+	{
+		const auto bigObject = bigObjects[i];
+		const uint64_t UObjectGamePtr = *reinterpret_cast<uint64_t*>(bigObject->object);
+		std::lock_guard lock(gUObjectManager.growLocks[(UObjectGamePtr >> 4) % std::size(gUObjectManager.growLocks)]);
+		if (bigObject->readSize.load(std::memory_order_acquire) >= requiredSize)
+			continue;
+
+		memcpy(bigObject->object + sizeof(uint64_t), buffer.data() + i * requiredSize + sizeof(uint64_t), requiredSize - sizeof(uint64_t));
+		bigObject->readSize.store(requiredSize, std::memory_order_release);
+	}
+}
+
+void ObjectsManager::growUObjectsToClassSize(const std::vector<uint64_t>& gamePtrs)
+{
+	//objects of the same class have the same size, so there is one batch per size
+	std::unordered_map<int, std::vector<uint64_t>> sizeBatches;
+	for (const auto gamePtr : gamePtrs)
+	{
+		const auto linkedObject = gUObjectManager.linkedUObjectPtrs.find(gamePtr);
+		if (!linkedObject)
+			continue;
+
+		//unknown class, all we can do is reading the max size
+		int size = UOBJECT_MAX_SIZE;
+		const auto classPtr = reinterpret_cast<uint64_t>(reinterpret_cast<UObject*>((*linkedObject)->object)->ClassPrivate);
+		if (const auto linkedClass = gUObjectManager.linkedUObjectPtrs.find(classPtr); linkedClass && (*linkedClass)->readSize.load(std::memory_order_acquire) >= sizeof(UStruct))
+		{
+			size = reinterpret_cast<UStruct*>((*linkedClass)->object)->PropertiesSize;
+			if (size < static_cast<int>(sizeof(UField)))
+				size = sizeof(UField);
+			if (size > UOBJECT_MAX_SIZE)
+				size = UOBJECT_MAX_SIZE;
+		}
+		sizeBatches[size].push_back(gamePtr);
+	}
+
+	for (const auto& [size, batch] : sizeBatches)
+		growUObjects(batch, size);
+}
+
+void ObjectsManager::prefetchEnumNames(const std::vector<uint64_t>& enumPtrs)
+{
+	//the Names array is behind the UObject header
+	growUObjects(enumPtrs, sizeof(UEnum));
+
+	std::vector<uint64_t> ptrs;
+	std::vector<std::vector<TPair<FName, int64_t>>> names;
+	std::vector<Memory::ScatterEntry> entries;
+	for (const auto enumPtr : enumPtrs)
+	{
+		if (enumNamesCache.contains(enumPtr))
+			continue;
+
+		const auto enu = getUObject<UEnum>(enumPtr);
+		if (!enu || enu->Names.Count <= 0 || !enu->Names.Data)
+			continue;
+
+		ptrs.push_back(enumPtr);
+		names.emplace_back(enu->Names.Count);
+	}
+	//vectors dont move anymore, now set the buffers
+	for (size_t i = 0; i < ptrs.size(); i++)
+	{
+		const auto enu = getUObject<UEnum>(ptrs[i]);
+		entries.push_back({ enu->Names.Data, names[i].data(), sizeof(TPair<FName, int64_t>) * names[i].size() });
+	}
+	Memory::readScatter(entries);
+
+	for (size_t i = 0; i < ptrs.size(); i++)
+		enumNamesCache.insert(ptrs[i], std::move(names[i]));
+}
+
+const std::vector<TPair<FName, int64_t>>* ObjectsManager::getCachedEnumNames(uint64_t enumPtr)
+{
+	return enumNamesCache.find(enumPtr);
+}
+
+bool ObjectsManager::readLiveObjectArray(TypeUObjectArray& objectArray)
+{
+	if (!gUObjectManager.UObjectArrayAddress)
+		return false;
+
+	objectArray = Memory::read<TypeUObjectArray>(gUObjectManager.UObjectArrayAddress);
+
+#if GOBJECTS_XOR_ECRYPTION_KEY
+#if UE_VERSION < UE_4_20
+	objectArray.Objects = reinterpret_cast<FUObjectItem*>((decryptPointer(reinterpret_cast<uint64_t>(objectArray.Objects))));
+#else
+	objectArray.Objects = reinterpret_cast<FUObjectItem**>((decryptPointer(reinterpret_cast<uint64_t>(objectArray.Objects))));
+#endif
+#endif
+	return objectArray.Objects != nullptr;
+}
+
+uint64_t ObjectsManager::getObjectChunkStart(int32_t chunkIndex)
+{
+#if UE_VERSION < UE_4_20
+	//no chunks, the whole array is one block
+	return chunkIndex == 0 ? reinterpret_cast<uint64_t>(gUObjectManager.UObjectArray.Objects) : 0;
+#else
+	if (chunkIndex < 0 || chunkIndex >= gUObjectManager.UObjectArray.MaxChunks)
+		return 0;
+
+	std::lock_guard lock(gRuntimeCache.chunkMutex);
+
+	auto& chunkPtrs = gRuntimeCache.chunkPtrs;
+	if (chunkPtrs.size() <= static_cast<size_t>(chunkIndex))
+		chunkPtrs.resize(chunkIndex + 1, 0);
+
+	//new chunks get allocated by the game while running, so only cache the ones that exist
+	if (!chunkPtrs[chunkIndex])
+	{
+		const auto chunkStart = Memory::read<uint64_t>(reinterpret_cast<uint64_t>(gUObjectManager.UObjectArray.Objects) + (chunkIndex * 0x8));
+		if (!chunkStart)
+			return 0;
+		chunkPtrs[chunkIndex] = chunkStart + CHUNK_PADDING;
+	}
+	return chunkPtrs[chunkIndex];
+#endif
+}
+
+uint64_t ObjectsManager::getFUObjectItemAddress(int32_t index)
+{
+	if (index < 0 || index >= gUObjectManager.UObjectArray.MaxElements)
+		return 0;
+
+#if UE_VERSION < UE_4_20
+	return getObjectChunkStart(0) + static_cast<uint64_t>(index) * FUOBJECTITEM_SIZE;
+#else
+	const uint64_t chunkStart = getObjectChunkStart(index / numElementsPerChunk);
+	if (!chunkStart)
+		return 0;
+
+	return chunkStart + static_cast<uint64_t>(index % numElementsPerChunk) * FUOBJECTITEM_SIZE;
+#endif
+}
+
+bool ObjectsManager::readFUObjectItem(int32_t index, FUObjectItem& item)
+{
+	const uint64_t itemAddress = getFUObjectItemAddress(index);
+	if (!itemAddress)
+		return false;
+
+	Memory::read(reinterpret_cast<void*>(itemAddress), &item, sizeof(FUObjectItem) < FUOBJECTITEM_SIZE ? sizeof(FUObjectItem) : FUOBJECTITEM_SIZE);
+	return true;
+}
+
+bool ObjectsManager::readFUObjectItems(int32_t start, int32_t count, std::vector<FUObjectItem>& items)
+{
+	if (start < 0 || count < 0 || static_cast<int64_t>(start) + count > gUObjectManager.UObjectArray.MaxElements)
+		return false;
+
+	items.assign(count, FUObjectItem{});
+	if (count == 0)
+		return true;
+
+	constexpr size_t copySize = sizeof(FUObjectItem) < FUOBJECTITEM_SIZE ? sizeof(FUObjectItem) : FUOBJECTITEM_SIZE;
+	std::vector<uint8_t> buffer;
+
+	int32_t done = 0;
+	while (done < count)
+	{
+		const int32_t index = start + done;
+#if UE_VERSION < UE_4_20
+		const int32_t chunkIndex = 0;
+		const int32_t inChunk = index;
+		const int32_t itemsInChunk = count - done;
+#else
+		const int32_t chunkIndex = index / numElementsPerChunk;
+		const int32_t inChunk = index % numElementsPerChunk;
+		const int32_t itemsInChunk = count - done < numElementsPerChunk - inChunk ? count - done : numElementsPerChunk - inChunk;
 #endif
+		//missing chunks just stay zeroed
+		if (const uint64_t chunkStart = getObjectChunkStart(chunkIndex))
+		{
+			buffer.resize(static_cast<size_t>(itemsInChunk) * FUOBJECTITEM_SIZE);
+			Memory::read(reinterpret_cast<void*>(chunkStart + static_cast<uint64_t>(inChunk) * FUOBJECTITEM_SIZE), buffer.data(), buffer.size());
+			for (int32_t i = 0; i < itemsInChunk; i++)
+				memcpy(&items[done + i], buffer.data() + static_cast<size_t>(i) * FUOBJECTITEM_SIZE, copySize);
+		}
+		done += itemsInChunk;
+	}
+	return true;
+}
+
+ObjectsManager::UObjectManager::UBigObject* ObjectsManager::getRuntimeObject(uint64_t gamePtr, int requiredSize)
+{
+	if (requiredSize > UOBJECT_MAX_SIZE)
+	{
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "OBJECTSMANAGER",
+			"HARD ERROR! A UObject tried to access more space (%d) than it can have max (%d). Try increasing UOBJECT_MAX_SIZE", requiredSize, UOBJECT_MAX_SIZE);
+		errorReason = windows::LogWindow::getLastLogMessage();
+		STOP_OPERATION();
+		return nullptr;
+	}
+
+	//we always need the UObject header to know the InternalIndex
+	const int readSize = requiredSize < static_cast<int>(sizeof(UObject)) ? static_cast<int>(sizeof(UObject)) : requiredSize;
+
+	std::lock_guard lock(gRuntimeCache.mutex);
+
+	if (!allocateRuntimeSlots())
+		return nullptr;
+
+	const int64_t now = getTickMs();
+
+	//reads the object into the slot and remembers its FUObjectItem serial
+	auto fillSlot = [&](RuntimeObjectCache::Slot* slot)
+	{
+		auto& bigObject = slot->bigObject;
+		Memory::read(reinterpret_cast<void*>(gamePtr), bigObject.object, readSize);
+		*reinterpret_cast<uint64_t*>(bigObject.object) = gamePtr;
+		bigObject.readSize = readSize;
+		bigObject.valid = true;
+
+		slot->gamePtr = gamePtr;
+		slot->internalIndex = reinterpret_cast<UObject*>(bigObject.object)->InternalIndex;
+		slot->serialNumber = 0;
+		FUObjectItem item{};
+		if (readFUObjectItem(slot->internalIndex, item) && item.Object == gamePtr)
+			slot->serialNumber = item.SerialNumber;
+		slot->validatedAt = now;
+		slot->referenced = true;
+	};
+
+	//the caller uses the object until it releases it
+	auto pinSlot = [&](size_t slotIndex)
+	{
+		RuntimeObjectCache::Slot* slot = &gRuntimeCache.slots[slotIndex];
+		slot->pins++;
+		gRuntimeCache.pins++;
+		heldRuntimeSlots.push_back(slotIndex);
+		return &slot->bigObject;
+	};
+
+	if (const auto it = gRuntimeCache.slotIndexes.find(gamePtr); it != gRuntimeCache.slotIndexes.end())
+	{
+		const size_t slotIndex = it->second;
+		RuntimeObjectCache::Slot* slot = &gRuntimeCache.slots[slotIndex];
+		slot->referenced = true;
+		gRuntimeCache.stats.hits++;
+
+		bool bStale = false;
+		if (now - slot->validatedAt >= RUNTIME_CACHE_REVALIDATE_MS)
+		{
+			//the object got destroyed or the slot in GObjects got reused, read it again
+			FUObjectItem item{};
+			bStale = !readFUObjectItem(slot->internalIndex, item) || item.Object != gamePtr || item.SerialNumber != slot->serialNumber;
+			if (!bStale)
+				slot->validatedAt = now;
+		}
+
+		if (bStale)
+		{
+			gRuntimeCache.stats.staleReloads++;
+			if (slot->pins == 0)
+			{
+				fillSlot(slot);
+				return pinSlot(slotIndex);
+			}
+			//someone still uses the old object, leave the slot to them and read it into another one
+			gRuntimeCache.slotIndexes.erase(it);
+			slot->referenced = false;
+		}
+		else
+		{
+			if (slot->bigObject.readSize < static_cast<size_t>(readSize))
+			{
+				//only the bytes behind the old size, other holders might read the ones before right now
+				const size_t oldSize = slot->bigObject.readSize;
+				Memory::read(reinterpret_cast<void*>(gamePtr + oldSize), slot->bigObject.object + oldSize, readSize - oldSize);
+				slot->bigObject.readSize = readSize;
+			}
+			return pinSlot(slotIndex);
+		}
+	}
+	else
+		gRuntimeCache.stats.misses++;
+
+	size_t slotIndex = 0;
+	if (!takeRuntimeSlot(slotIndex))
+		return nullptr;
+
+	fillSlot(&gRuntimeCache.slots[slotIndex]);
+	gRuntimeCache.slotIndexes.insert(std::pair(gamePtr, slotIndex));
+
+	return pinSlot(slotIndex);
+}
+
+bool ObjectsManager::allocateRuntimeSlots()
+{
+	applyRuntimeCacheBudget();
+
+	//allocate the slots once, the runtime cache never grows beyond this
+	if (gRuntimeCache.slots)
+		return true;
+
+	gRuntimeCache.capacity = gRuntimeCache.budget / sizeof(RuntimeObjectCache::Slot);
+	if (gRuntimeCache.capacity < 16)
+		gRuntimeCache.capacity = 16;
+
+	gRuntimeCache.slots = static_cast<RuntimeObjectCache::Slot*>(calloc(gRuntimeCache.capacity, sizeof(RuntimeObjectCache::Slot)));
+	if (!gRuntimeCache.slots)
+	{
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "OBJECTSMANAGER",
+			"HARD ERROR! Could not allocate the runtime cache (%llu slots)! Not enough ram? Try decreasing RUNTIME_CACHE_BUDGET", gRuntimeCache.capacity);
+		errorReason = windows::LogWindow::getLastLogMessage();
+		gRuntimeCache.capacity = 0;
+		STOP_OPERATION();
+		return false;
+	}
+	gRuntimeCache.slotIndexes.reserve(gRuntimeCache.capacity);
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "OBJECTSMANAGER",
+		"Allocated runtime cache with %llu slots (0x%llX bytes)", gRuntimeCache.capacity, gRuntimeCache.capacity * sizeof(RuntimeObjectCache::Slot));
+	return true;
+}
+
+bool ObjectsManager::takeRuntimeSlot(size_t& slotIndex)
+{
+	if (gRuntimeCache.usedSlots < gRuntimeCache.capacity)
+	{
+		//there are still free slots
+		slotIndex = gRuntimeCache.usedSlots++;
+		return true;
+	}
+
+	//CLOCK: give every referenced slot a second chance, evict the first one that was not used since the last round.
+	//Pinned slots are skipped, after two rounds every unpinned slot had its chance
+	bool bFound = false;
+	for (size_t i = 0; i < 2 * gRuntimeCache.capacity; i++)
+	{
+		RuntimeObjectCache::Slot* candidate = &gRuntimeCache.slots[gRuntimeCache.clockHand];
+		if (candidate->pins == 0 && !candidate->referenced)
+		{
+			bFound = true;
+			break;
+		}
+		candidate->referenced = false;
+		gRuntimeCache.clockHand = (gRuntimeCache.clockHand + 1) % gRuntimeCache.capacity;
+	}
+	if (!bFound)
+	{
+		static bool bWarned = false;
+		if (!bWarned)
+		{
+			windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "OBJECTSMANAGER",
+				"Every slot of the runtime cache is in use! Try increasing RUNTIME_CACHE_BUDGET");
+			bWarned = true;
+		}
+		return false;
+	}
+	slotIndex = gRuntimeCache.clockHand;
+	gRuntimeCache.clockHand = (gRuntimeCache.clockHand + 1) % gRuntimeCache.capacity;
+
+	//the slot might not be linked anymore if it got replaced after going stale
+	if (const auto old = gRuntimeCache.slotIndexes.find(gRuntimeCache.slots[slotIndex].gamePtr); old != gRuntimeCache.slotIndexes.end() && old->second == slotIndex)
+		gRuntimeCache.slotIndexes.erase(old);
+	gRuntimeCache.stats.evictions++;
+	return true;
+}
+
+void ObjectsManager::applyRuntimeCacheBudget()
+{
+	if (!gRuntimeCache.bResizePending || gRuntimeCache.pins > 0)
+		return;
+
+	free(gRuntimeCache.slots);
+	gRuntimeCache.slots = nullptr;
+	gRuntimeCache.capacity = 0;
+	gRuntimeCache.usedSlots = 0;
+	gRuntimeCache.clockHand = 0;
+	gRuntimeCache.slotIndexes.clear();
+	gRuntimeCache.bResizePending = false;
+}
 
 void ObjectsManager::setSDKGenerationDone()
 {
 	cacheState = CS_RUNTIME;
+}
+
+void ObjectsManager::setRuntimeCacheBudget(size_t bytes)
+{
+	std::lock_guard lock(gRuntimeCache.mutex);
+
+	//the slots get allocated again with the new budget at the next runtime request, handed out objects stay valid until then
+	gRuntimeCache.budget = bytes;
+	gRuntimeCache.bResizePending = true;
+	applyRuntimeCacheBudget();
+}
+
+void ObjectsManager::releaseRuntimeObjects()
+{
+	if (heldRuntimeSlots.empty())
+		return;
+
+	std::lock_guard lock(gRuntimeCache.mutex);
+
+	for (const auto slotIndex : heldRuntimeSlots)
+		gRuntimeCache.slots[slotIndex].pins--;
+	gRuntimeCache.pins -= static_cast<int64_t>(heldRuntimeSlots.size());
+	heldRuntimeSlots.clear();
+
+	applyRuntimeCacheBudget();
+}
+
+void ObjectsManager::prefetchRuntimeObjects(const std::vector<uint64_t>& gamePtrs)
+{
+	if (cacheState != CS_RUNTIME)
+		return;
+
+	//only the ones that are not cached yet, objects of the SDK generation are pinned anyways
+	std::vector<uint64_t> newPtrs;
+	{
+		std::lock_guard lock(gRuntimeCache.mutex);
+		std::unordered_set<uint64_t> batchPtrs;
+		for (const auto gamePtr : gamePtrs)
+		{
+			if (!gamePtr || gUObjectManager.linkedUObjectPtrs.contains(gamePtr) || gRuntimeCache.slotIndexes.contains(gamePtr) || !batchPtrs.insert(gamePtr).second)
+				continue;
+			newPtrs.push_back(gamePtr);
+		}
+	}
+	if (newPtrs.empty())
+		return;
+
+	//read everything without holding the lock, so the UI can keep using the cache. First the objects themselves
+	std::vector<UObject> objects(newPtrs.size());
+	std::vector<Memory::ScatterEntry> entries(newPtrs.size());
+	for (size_t i = 0; i < newPtrs.size(); i++)
+		entries[i] = { reinterpret_cast<void*>(newPtrs[i]), &objects[i], sizeof(UObject) };
+	Memory::readScatter(entries);
+
+	//then their FUObjectItems for the serials
+	constexpr size_t itemSize = sizeof(FUObjectItem) < FUOBJECTITEM_SIZE ? sizeof(FUObjectItem) : FUOBJECTITEM_SIZE;
+	std::vector<FUObjectItem> items(newPtrs.size());
+	entries.clear();
+	for (size_t i = 0; i < newPtrs.size(); i++)
+	{
+		if (const uint64_t itemAddress = getFUObjectItemAddress(objects[i].InternalIndex))
+			entries.push_back({ reinterpret_cast<void*>(itemAddress), &items[i], itemSize });
+	}
+	Memory::readScatter(entries);
+
+	const int64_t now = getTickMs();
+
+	std::lock_guard lock(gRuntimeCache.mutex);
+
+	if (!allocateRuntimeSlots())
+		return;
+
+	for (size_t i = 0; i < newPtrs.size(); i++)
+	{
+		const uint64_t gamePtr = newPtrs[i];
+		//someone requested it while we were reading
+		if (gRuntimeCache.slotIndexes.contains(gamePtr))
+			continue;
+
+		size_t slotIndex = 0;
+		if (!takeRuntimeSlot(slotIndex))
+			return;
+
+		RuntimeObjectCache::Slot* slot = &gRuntimeCache.slots[slotIndex];
+		auto& bigObject = slot->bigObject;
+		memcpy(bigObject.object, &objects[i], sizeof(UObject));
+		*reinterpret_cast<uint64_t*>(bigObject.object) = gamePtr;
+		bigObject.readSize = sizeof(UObject);
+		bigObject.valid = true;
+
+		slot->gamePtr = gamePtr;
+		slot->internalIndex = objects[i].InternalIndex;
+		slot->serialNumber = items[i].Object == gamePtr ? items[i].SerialNumber : 0;
+		slot->validatedAt = now;
+		//prefetched objects get evicted first if nobody uses them
+		slot->referenced = false;
+
+		gRuntimeCache.slotIndexes.insert(std::pair(gamePtr, slotIndex));
+		gRuntimeCache.stats.prefetches++;
+	}
+}
+
+void ObjectsManager::invalidateRuntimeObjects(const std::vector<uint64_t>& gamePtrs)
+{
+	std::lock_guard lock(gRuntimeCache.mutex);
+
+	for (const auto gamePtr : gamePtrs)
+	{
+		if (const auto it = gRuntimeCache.slotIndexes.find(gamePtr); it != gRuntimeCache.slotIndexes.end())
+			gRuntimeCache.slots[it->second].validatedAt = 0;
+	}
+}
+
+ObjectsManager::RuntimeCacheStats ObjectsManager::getRuntimeCacheStats()
+{
+	std::lock_guard lock(gRuntimeCache.mutex);
+
+	RuntimeCacheStats stats = gRuntimeCache.stats;
+	stats.usedSlots = gRuntimeCache.usedSlots;
+	stats.capacity = gRuntimeCache.capacity;
+	return stats;
 }
\ No newline at end of file
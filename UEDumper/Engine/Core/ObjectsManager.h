@@ -4,6 +4,8 @@
 #include "stdafx.h"
 #include "../structs.h"
 #include "EngineStructs.h"
+#include "MappedBuffer.h"
+#include "CancellationToken.h"
 #include "Frontend/Windows/LogWindow.h"
 #include "Memory/memory.h"
 
@@ -23,6 +25,24 @@
 //But if you have to, look at the size of UFunction, these objects are the largest.
 #define UOBJECT_MAX_SIZE 0x150
 
+//memory budget in bytes for the runtime object cache. At runtime (live editor) every object that is not part of
+//the SDK generation gets cached here. Once the budget is reached, old objects get evicted (CLOCK algorithm).
+#define RUNTIME_CACHE_BUDGET (64 * 1024 * 1024)
+
+//time in ms after which a cached runtime object gets validated again against its FUObjectItem serial number
+#define RUNTIME_CACHE_REVALIDATE_MS 2000
+
+//whether the GObject pointer array and the UBigObject array should be placed in a sparse temp file mapped into memory
+//instead of ram. Enable this for games with millions of objects, the OS then pages cold objects out.
+#define USE_MAPPED_OBJECT_ARRAYS FALSE
+
+//max number of objects that are accepted before the offset is considered wrong. The mapped arrays can take way more.
+#if USE_MAPPED_OBJECT_ARRAYS
+#define MAX_OBJECT_ELEMENTS 400000000
+#else
+#define MAX_OBJECT_ELEMENTS 50000000
+#endif
+
 #if UE_VERSION >= UE_4_25
 //the number of FFIELDS to cache. You shouldnt have to change this, this is just for allocating a large enough buffer
 #define FFIELD_CT 400000
@@ -85,6 +105,20 @@ public:
 	typedef FChunkedFixedUObjectArray TypeUObjectArray;
 #endif
 
+	//counters of the runtime object cache
+	struct RuntimeCacheStats
+	{
+		int64_t hits = 0;
+		int64_t misses = 0;
+		int64_t evictions = 0;
+		//objects that got read again because their FUObjectItem changed
+		int64_t staleReloads = 0;
+		//objects that got read in before anyone requested them (ObjectWatcher)
+		int64_t prefetches = 0;
+		size_t usedSlots = 0;
+		size_t capacity = 0;
+	};
+
 private:
 
 	friend class EngineCore;
@@ -102,39 +136,148 @@ private:
 	{
 
 		//UBigObject struct. The readSize indicates how many bytes are valid in the array.
-#pragma pack(push, 1)
+		//Not packed, readSize has to be aligned to be atomic
 		struct UBigObject
 		{
 			bool valid = false;
-			//valid bytes in the char array
-			size_t readSize = 0;
+			//valid bytes in the char array. Objects get grown while other threads read them, so the bytes get
+			//written first and then published with a release store, readers load it with acquire before using the bytes
+			std::atomic<size_t> readSize = 0;
 			//if you ask where if the paired UObject game ptr?
 			//Well it actually is at object buff + 0! tldr Core.cpp@copyUBigObjects
 			char object[UOBJECT_MAX_SIZE];
 		};
-#pragma pack(pop)
 
 		//ptr to the allocated buffer where all UObject pointers related to the SDK are located
 		uint64_t pGObjectPtrArray = 0;
 		//ptr to the allocated buffer where all UObjects related to the SDK  are located
 		uint64_t pUBigObjectArray = 0;
 
+#if USE_MAPPED_OBJECT_ARRAYS
+		//file backed storage of the two arrays above
+		MappedBuffer GObjectPtrBuffer;
+		MappedBuffer UBigObjectBuffer;
+#endif
+
 		//linkage like following: fn ptr to uedumper ptr
-		std::unordered_map<uint64_t, UBigObject*> linkedUObjectPtrs{};
+		ConcurrentMap<uint64_t, UBigObject*> linkedUObjectPtrs{};
+
+		//striped locks for growing UBigObjects, two threads must not read the same object at once
+		std::mutex growLocks[64];
+
+		//objects that are referenced but were not in our copy of the object array (e.g created after it). They are pinned like the others.
+		std::vector<UBigObject*> overflowBlocks{};
+		size_t overflowCount = 0;
+		std::mutex overflowMutex;
 
 		//Object array that gets scanned once at the beginning (should match the UE versions type)
 		TypeUObjectArray UObjectArray;
+
+		//game address of the object array, used to read it again at runtime
+		uint64_t UObjectArrayAddress = 0;
 	};
 
 	inline static UObjectManager gUObjectManager = {};
 
+	//cache for all the objects that get requested at runtime but are not part of the SDK generation.
+	//Objects from the SDK generation stay pinned in the UObjectManager, these here get evicted once the budget is reached.
+	struct RuntimeObjectCache
+	{
+		struct Slot
+		{
+			//game pointer of the object, 0 if the slot is free
+			uint64_t gamePtr = 0;
+			//InternalIndex and serial of the FUObjectItem at the time we read the object
+			int32_t internalIndex = -1;
+			int32_t serialNumber = 0;
+			//time in ms when the object was validated the last time
+			int64_t validatedAt = 0;
+			//CLOCK reference bit, set on every access and cleared by the clock hand
+			bool referenced = false;
+			//handed out objects that were not released yet. Pinned slots never get evicted or read again
+			int pins = 0;
+			UObjectManager::UBigObject bigObject;
+		};
+
+		//budget in bytes, the slot count is calculated out of this
+		size_t budget = RUNTIME_CACHE_BUDGET;
+		//the budget changed, the slots get allocated again once nothing is pinned anymore
+		bool bResizePending = false;
+		//pins of all slots together
+		int64_t pins = 0;
+
+		//flat slot array, allocated once at the first runtime request
+		Slot* slots = nullptr;
+		size_t capacity = 0;
+		size_t usedSlots = 0;
+		size_t clockHand = 0;
+
+		//linkage like following: game ptr to slot index
+		std::unordered_map<uint64_t, size_t> slotIndexes{};
+
+		//cached chunk pointers of the games object array, chunks never move once they got allocated
+		std::vector<uint64_t> chunkPtrs{};
+		std::mutex chunkMutex;
+
+		std::mutex mutex;
+
+		RuntimeCacheStats stats;
+	};
+
+	inline static RuntimeObjectCache gRuntimeCache = {};
+
+	/**
+	 * \brief RUNTIME ONLY! Gets the object out of the runtime cache or reads it into a (possibly evicted) slot.
+	 * Also validates the object against its FUObjectItem if RUNTIME_CACHE_REVALIDATE_MS passed.
+	 * The slot stays pinned until the calling thread calls releaseRuntimeObjects.
+	 * \param gamePtr game pointer to the UObject
+	 * \param requiredSize the required size of the object
+	 * \return the UBigObject or nullptr if every slot is pinned
+	 */
+	static UObjectManager::UBigObject* getRuntimeObject(uint64_t gamePtr, int requiredSize);
+
+	/**
+	 * \brief DO NOT CALL WITHOUT THE LOCK! Frees the slots if the budget changed and nothing is pinned, they get allocated again at the next request
+	 */
+	static void applyRuntimeCacheBudget();
+
+	/**
+	 * \brief DO NOT CALL WITHOUT THE LOCK! Allocates the slots of the runtime cache if they arent yet
+	 * \return false if the allocation failed
+	 */
+	static bool allocateRuntimeSlots();
+
+	/**
+	 * \brief DO NOT CALL WITHOUT THE LOCK! Gets a free slot or evicts one with CLOCK. The slot is unlinked afterwards
+	 * \param slotIndex index of the slot
+	 * \return false if every slot is pinned
+	 */
+	static bool takeRuntimeSlot(size_t& slotIndex);
+
+	/**
+	 * \brief gets the game address of the FUObjectItem in the games object array
+	 * \param index InternalIndex of the object
+	 * \return the address or 0 if the index is invalid or its chunk doesnt exist (yet)
+	 */
+	static uint64_t getFUObjectItemAddress(int32_t index);
+
+	/**
+	 * \brief gets the start of the chunk in the games object array, cached after the first read
+	 * \param chunkIndex index of the chunk
+	 * \return the game address of the first FUObjectItem in the chunk or 0 if the chunk doesnt exist (yet)
+	 */
+	static uint64_t getObjectChunkStart(int32_t chunkIndex);
+
 #if UE_VERSION >= UE_4_25
 
 	struct FFieldManager
 	{
+		//writers lock this for allocating a new FField or FFieldClass in the buffers, reads are lock free
+		std::mutex cacheMutex;
+
 		//FField
 		int linkedFFieldIndexCount = 0;
-		std::unordered_map<uint64_t, uint64_t> linkedFFieldPtrs{};
+		ConcurrentMap<uint64_t, uint64_t> linkedFFieldPtrs{};
 
 		//ptr to the allocated buffer where all FFields are located
 		uint64_t pFFieldArray = 0;
@@ -144,7 +287,7 @@ private:
 
 		//FFieldClass
 		int linkedFFieldClassIndexCount = 0;
-		std::unordered_map<uint64_t, uint64_t> linkedFFieldClassPtrs{};
+		ConcurrentMap<uint64_t, uint64_t> linkedFFieldClassPtrs{};
 
 		//ptr to the allocated buffer where all FFieldClasses are located
 		uint64_t pFFieldClassArray = 0;
@@ -155,6 +298,9 @@ private:
 	inline static FFieldManager gFFieldManager = {};
 #endif
 
+	//names of the enums that got read in a batch, linkage like following: enum ptr to names
+	inline static ConcurrentMap<uint64_t, std::vector<TPair<FName, int64_t>>> enumNamesCache{};
+
 	/**
 	* \brief USE ONLY AFTER UBIGOBJECT GENERATION! Makes sure the required size is also copied
 	* OPERATION CHECK NEEDED
@@ -163,6 +309,21 @@ private:
 	*/
 	static void verifyUBigObjectSize(UObjectManager::UBigObject* bigObjectPtr, int requiredSize);
 
+	/**
+	 * \brief caches the objects that are not in the cache yet in the overflow arena with one batched read.
+	 * Only pointers whose FUObjectItem at their InternalIndex points back at them are taken, everything else
+	 * is no object and stays uncached
+	 * \param gamePtrs game pointers to the UObjects
+	 * \return number of objects that got added
+	 */
+	static size_t cacheOverflowObjects(const std::vector<uint64_t>& gamePtrs);
+
+	/**
+	 * \brief reads all the ClassPrivate, OuterPrivate and SuperStruct targets of the cached objects in batches
+	 * and repeats this until no new pointers appear. Afterwards the object graph is closed and fully in the cache.
+	 */
+	static void prefetchReferencedObjects();
+
 	
 
 	/**
@@ -180,6 +341,51 @@ private:
 
 	static inline bool _STOP_OPERATION = false;
 
+	//cancellation of the dump, every check of CRITICAL_STOP_CALLED checks it as well
+	static inline CancellationToken dumpCancellation{};
+
+	//header of the UBigObjects.bin checkpoint
+	struct ObjectCheckpointHeader
+	{
+		char magic[4] = { 'U', 'E', 'D', 'O' };
+		uint32_t version = 1;
+		//EngineCore::getTargetFingerprint
+		uint64_t fingerprint = 0;
+		//game address of the chunk table, a new one means the game got restarted
+		uint64_t objectArray = 0;
+		int32_t numElements = 0;
+		//number of objects in UBigObjects.bin
+		int32_t count = 0;
+		//the pointer array the objects belong to
+		uint64_t snapshotId = 0;
+	};
+
+	//each UBigObjects.bin entry is followed by readSize bytes of the object
+	struct ObjectCheckpointEntry
+	{
+		int32_t index;
+		uint32_t readSize;
+	};
+
+	//hash of the copied pointer array, the objects and packages checkpoints belong to it. 0 if checkpoints are off
+	static inline uint64_t objectSnapshotId = 0;
+	//the UBigObjects came out of UBigObjects.bin, so theres no need to write it again
+	static inline bool bObjectsFromCheckpoint = false;
+
+	/**
+	 * \brief allocates the buffer for the GObject pointers
+	 * \param bytes size of the buffer
+	 * \return true upon success
+	 */
+	static bool allocateGObjectPtrArray(int64_t bytes);
+
+	/**
+	 * \brief loads UBigObjects.bin into the allocated UBigObject array if it belongs to the current pointer array
+	 * \param finishedBytes progress, like the copy
+	 * \return true if the objects got loaded
+	 */
+	static bool loadObjectCheckpoint(int64_t& finishedBytes);
+
 public:
 
 	
@@ -188,11 +394,17 @@ public:
 	ObjectsManager();
 
 	/**
-	 * \brief Checks whether this or previous operations were not success. Only true when critical memory errors happen, however they have to be handled accordingly
+	 * \brief Checks whether this or previous operations were not success. Only true when critical memory errors happen, however they have to be handled accordingly.
+	 * Also true once the dump got cancelled, so everything that stops on a critical stop stops on a cancel as well
 	 * \return critical stop called
 	 */
 	static bool CRITICAL_STOP_CALLED();
 
+	/**
+	 * \brief the token that cancels the dump. Reset it together with resolvedStop before the dump runs again
+	 */
+	static CancellationToken& getCancellationToken();
+
 	/**
 	 * \brief Only call this function if you are able to recover from a critical stop!
 	 */
@@ -214,8 +426,16 @@ public:
 	 * \param finishedBytes bytes already copied
 	 * \param totalBytes total bytes that need to be copied
 	 * \param status status of the operation
+	 * \param copiedChunks optional queue that gets every chunk of objects once it is copied. Gets closed when all objects are copied
+	 */
+	static void copyUBigObjects(int64_t& finishedBytes, int64_t& totalBytes, CopyStatus& status, BoundedQueue<ObjectChunk>* copiedChunks = nullptr);
+
+	/**
+	 * \brief writes every valid UBigObject into UBigObjects.bin unless they got loaded out of it.
+	 * Call it once the FNames are cached too and before anything else grows the objects
+	 * \return true upon success
 	 */
-	static void copyUBigObjects(int64_t& finishedBytes, int64_t& totalBytes, CopyStatus& status);
+	static bool saveObjectCheckpoint();
 
 	/**
 	 * \brief USE ONLY AFTER UBIGOBJECT GENERATION! ONLY USE FOR UOBJECTS! ONLY USE FOR SDK!!
@@ -272,7 +492,8 @@ public:
 			//DebugBreak();
 		}
 #endif
-		if(!gUObjectManager.linkedUObjectPtrs.contains(gamePtr))
+		const auto linkedObject = gUObjectManager.linkedUObjectPtrs.find(gamePtr);
+		if(!linkedObject)
 		{
 			if(cacheState == CacheState::CS_SDKGEN)
 			{
@@ -283,29 +504,19 @@ public:
 			}
 			if (cacheState == CacheState::CS_RUNTIME)
 			{
-				//allocate enough space for the item
-				UObjectManager::UBigObject* bigObject = static_cast<UObjectManager::UBigObject*>(calloc(1, sizeof(UObjectManager::UBigObject)));
+				//objects that are not pinned by the SDK generation go into the bounded runtime cache.
+				//The returned object stays valid until this thread calls releaseRuntimeObjects.
+				UObjectManager::UBigObject* bigObject = getRuntimeObject(gamePtr, sizeof(T));
 				if (bigObject == nullptr)
-				{
-					windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "OBJECTSMANAGER",
-						"HARD ERROR! Could not allocate a new bigObject (size %d) for %llX! Not enough ram?", sizeof(UObjectManager::UBigObject), gamePtr);
-					errorReason = windows::LogWindow::getLastLogMessage();
-					STOP_OPERATION();
 					return nullptr;
-				}
-				//read the memory of the object, override the vtable and set the readsize
-				Memory::read(reinterpret_cast<void*>(gamePtr), bigObject->object, sizeof(T));
-				*reinterpret_cast<uint64_t*>(bigObject->object) = gamePtr;
-				bigObject->readSize = sizeof(T);
-				gUObjectManager.linkedUObjectPtrs.insert(std::pair(gamePtr, bigObject));
-				//and return the object
+
 				return reinterpret_cast<T*>(bigObject->object);
 			}
 			//invalid state
 			return nullptr;
 				
 		}
-		UObjectManager::UBigObject* bigObject = gUObjectManager.linkedUObjectPtrs[gamePtr];
+		UObjectManager::UBigObject* bigObject = *linkedObject;
 		verifyUBigObjectSize(bigObject, sizeof(T));
 
 		if (CRITICAL_STOP_CALLED())
@@ -345,10 +556,10 @@ public:
 			return nullptr;
 
 		//check if the object is in out cache
-		if (EngineCore::fullStringCache.contains(name))
+		if (const auto cachedPtr = EngineCore::fullStringCache.find(name))
 		{
 			//get the UObject from the fn ptr in the map
-			return getUObject<T>(EngineCore::fullStringCache[name]);
+			return getUObject<T>(*cachedPtr);
 		}
 
 		for (int32_t i = 0; i < gUObjectManager.UObjectArray.NumElements; i++) {
@@ -408,9 +619,9 @@ public:
 	template <typename T>
 	static T* getFField(uint64_t gamePtr)
 	{
-		if (gFFieldManager.linkedFFieldPtrs.contains(gamePtr))
+		if (const auto cachedField = gFFieldManager.linkedFFieldPtrs.find(gamePtr))
 		{
-			return reinterpret_cast<T*>(gFFieldManager.linkedFFieldPtrs[gamePtr]);
+			return reinterpret_cast<T*>(*cachedField);
 		}
 		//element is not cached, go add it
 
@@ -437,10 +648,108 @@ public:
 	 */
 	static FFieldClass* getFFieldClass(void* gamePtr);
 
+	/**
+	 * \brief ONLY USE FOR FFIELDS! Caches all the FFields that are not cached yet with one batched read
+	 * \param gamePtrs game pointers to the FFields
+	 */
+	static void prefetchFFields(const std::vector<uint64_t>& gamePtrs);
+
+	/**
+	 * \brief ONLY USE FOR FFIELDS! Caches all the FFieldClasses that are not cached yet with one batched read
+	 * \param gamePtrs game pointers to the FFieldClasses
+	 */
+	static void prefetchFFieldClasses(const std::vector<uint64_t>& gamePtrs);
+
 #endif
 
+	/**
+	 * \brief USE ONLY AFTER UBIGOBJECT GENERATION! Batched version of verifyUBigObjectSize,
+	 * reads all cached objects that are smaller than the required size with one batched read.
+	 * Objects that are not cached are skipped.
+	 * \param gamePtrs game pointers to the UObjects
+	 * \param requiredSize the required size for the UObjects
+	 */
+	static void growUObjects(const std::vector<uint64_t>& gamePtrs, int requiredSize);
+
+	/**
+	 * \brief USE ONLY AFTER UBIGOBJECT GENERATION! Like growUObjects, but every object gets read at the
+	 * PropertiesSize of its class (bounded by UOBJECT_MAX_SIZE). Objects with an uncached class get the max size
+	 * \param gamePtrs game pointers to the UObjects
+	 */
+	static void growUObjectsToClassSize(const std::vector<uint64_t>& gamePtrs);
+
+	/**
+	 * \brief reads the names of all the enums with one batched read, UEnum::getNames uses them afterwards
+	 * \param enumPtrs game pointers to the UEnums
+	 */
+	static void prefetchEnumNames(const std::vector<uint64_t>& enumPtrs);
+
+	/**
+	 * \brief gets the names of a enum that got read in prefetchEnumNames
+	 * \param enumPtr game pointer to the UEnum
+	 * \return the names or nullptr if they were not prefetched
+	 */
+	static const std::vector<TPair<FName, int64_t>>* getCachedEnumNames(uint64_t enumPtr);
+
 	static void setSDKGenerationDone();
 
+	/**
+	 * \brief sets the memory budget of the runtime object cache. Clears all runtime cached objects
+	 * once no thread uses one of them anymore.
+	 * \param bytes budget in bytes
+	 */
+	static void setRuntimeCacheBudget(size_t bytes);
+
+	/**
+	 * \brief RUNTIME ONLY! Releases every object the calling thread got out of the runtime cache, they may get evicted afterwards.
+	 * The UI thread calls it after every frame, other threads have to call it once they dont use the objects anymore
+	 */
+	static void releaseRuntimeObjects();
+
+	/**
+	 * \brief gets the current counters of the runtime object cache
+	 * \return the stats
+	 */
+	static RuntimeCacheStats getRuntimeCacheStats();
+
+	/**
+	 * \brief reads the object array header of the game again, e.g to get the current NumElements
+	 * \param objectArray the array that gets filled
+	 * \return true if the object array could be read
+	 */
+	static bool readLiveObjectArray(TypeUObjectArray& objectArray);
+
+	/**
+	 * \brief reads the FUObjectItem for the given index from the games object array
+	 * \param index InternalIndex of the object
+	 * \param item the item that gets filled
+	 * \return true if the index is valid and got read
+	 */
+	static bool readFUObjectItem(int32_t index, FUObjectItem& item);
+
+	/**
+	 * \brief bulk reads a range of FUObjectItems from the games object array, one read per chunk
+	 * \param start index of the first item
+	 * \param count number of items
+	 * \param items vector that gets filled with count items. Items in missing chunks are zeroed
+	 * \return true if the range is valid
+	 */
+	static bool readFUObjectItems(int32_t start, int32_t count, std::vector<FUObjectItem>& items);
+
+	/**
+	 * \brief RUNTIME ONLY! Reads the objects into the runtime cache before the live editor requests them.
+	 * Objects that are already pinned by the SDK generation or already cached are skipped. The objects and their
+	 * FUObjectItems are read with two scatter reads without holding the cache lock.
+	 * \param gamePtrs game pointers to the UObjects
+	 */
+	static void prefetchRuntimeObjects(const std::vector<uint64_t>& gamePtrs);
+
+	/**
+	 * \brief RUNTIME ONLY! Forces the cached objects to be validated at their next access, e.g because they got destroyed
+	 * \param gamePtrs game pointers to the UObjects
+	 */
+	static void invalidateRuntimeObjects(const std::vector<uint64_t>& gamePtrs);
+
 	inline static uint64_t decryptPointer(uint64_t ptr)
 	{
 #if GOBJECTS_XOR_ECRYPTION_KEY
@@ -0,0 +1,194 @@
+#include "StageGraph.h"
+
+#include "ThreadPool.h"
+#include "Frontend/Windows/LogWindow.h"
+
+int StageGraph::addStage(const std::string& name, const std::vector<int>& dependencies, const std::function<bool(Stage&)>& func)
+{
+	Stage stage;
+	stage.name = name;
+	stage.dependencies = dependencies;
+	stage.func = func;
+	stages.push_back(std::move(stage));
+	return static_cast<int>(stages.size()) - 1;
+}
+
+bool StageGraph::runReadyStage()
+{
+	int index;
+	{
+		std::lock_guard lock(stagesMutex);
+		if (readyStages.empty())
+			return false;
+		index = readyStages.front();
+		readyStages.pop_front();
+	}
+
+	auto& stage = stages[index];
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "STAGEGRAPH", "Starting %s...", stage.name.c_str());
+	const auto start = std::chrono::steady_clock::now();
+	//busy until the stage says otherwise, so stages without own progress still show up
+	stage.status = CopyStatus::CS_busy;
+	const bool bSuccess = stage.func(stage);
+	stage.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (bSuccess)
+		stage.status = CopyStatus::CS_success;
+	else
+	{
+		stage.status = CopyStatus::CS_error;
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ERROR, "STAGEGRAPH", "%s failed!", stage.name.c_str());
+	}
+
+	int readyCount;
+	{
+		std::lock_guard lock(stagesMutex);
+		readyCount = finishStage(index, bSuccess);
+		stagesCondition.notify_all();
+	}
+	submitTasks(readyCount);
+	return true;
+}
+
+int StageGraph::finishStage(int index, bool bSuccess)
+{
+	finishedStages++;
+	int readyCount = 0;
+	for (const int dependent : stages[index].dependents)
+	{
+		if (!bSuccess)
+		{
+			skipStage(dependent);
+			continue;
+		}
+		//a stage that got skipped by another dependency never gets ready
+		if (--stages[dependent].missingDependencies == 0 && !stages[dependent].bSkipped)
+		{
+			readyStages.push_back(dependent);
+			readyCount++;
+		}
+	}
+	return readyCount;
+}
+
+void StageGraph::skipStage(int index)
+{
+	auto& stage = stages[index];
+	if (stage.bSkipped)
+		return;
+	stage.bSkipped = true;
+	finishedStages++;
+	for (const int dependent : stage.dependents)
+		skipStage(dependent);
+}
+
+void StageGraph::submitTasks(int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		{
+			std::lock_guard lock(stagesMutex);
+			pendingTasks++;
+		}
+		//the task might find nothing if another thread took the stage already, thats fine
+		ThreadPool::submit([this]
+			{
+				runReadyStage();
+				std::lock_guard lock(stagesMutex);
+				pendingTasks--;
+				stagesCondition.notify_all();
+			});
+	}
+}
+
+bool StageGraph::run()
+{
+	int readyCount = 0;
+	{
+		std::lock_guard lock(stagesMutex);
+		//stages that succeeded in an earlier run stay done, the others start over
+		readyStages.clear();
+		finishedStages = 0;
+		for (auto& stage : stages)
+		{
+			stage.dependents.clear();
+			stage.missingDependencies = 0;
+			stage.bSkipped = false;
+			if (stage.status == CopyStatus::CS_success)
+			{
+				finishedStages++;
+				continue;
+			}
+			stage.finishedItems = 0;
+			stage.totalItems = 1;
+			stage.status = CopyStatus::CS_idle;
+			stage.errorMessage.clear();
+		}
+		for (int i = 0; i < stages.size(); i++)
+		{
+			if (stages[i].status == CopyStatus::CS_success)
+				continue;
+			for (const int dependency : stages[i].dependencies)
+			{
+				if (stages[dependency].status == CopyStatus::CS_success)
+					continue;
+				stages[dependency].dependents.push_back(i);
+				stages[i].missingDependencies++;
+			}
+		}
+		for (int i = 0; i < stages.size(); i++)
+		{
+			if (stages[i].status != CopyStatus::CS_success && stages[i].missingDependencies == 0)
+			{
+				readyStages.push_back(i);
+				readyCount++;
+			}
+		}
+	}
+	//one less task, this thread takes a stage as well
+	if (readyCount > 1)
+		submitTasks(readyCount - 1);
+
+	//this thread also runs stages. A stage may block until another one runs (e.g. both ends of a BoundedQueue),
+	//so there are always at least two threads, this one and a worker
+	std::unique_lock lock(stagesMutex);
+	while (finishedStages < stages.size())
+	{
+		if (!readyStages.empty())
+		{
+			lock.unlock();
+			runReadyStage();
+			lock.lock();
+			continue;
+		}
+		stagesCondition.wait(lock);
+	}
+	stagesCondition.wait(lock, [this] { return pendingTasks == 0; });
+
+	return getFailedStage() == nullptr;
+}
+
+bool StageGraph::isStageDone(int index) const
+{
+	return stages[index].status == CopyStatus::CS_success;
+}
+
+const StageGraph::Stage* StageGraph::getFailedStage() const
+{
+	for (const auto& stage : stages)
+	{
+		if (stage.status == CopyStatus::CS_error)
+			return &stage;
+	}
+	return nullptr;
+}
+
+void StageGraph::logTimings() const
+{
+	for (const auto& stage : stages)
+	{
+		if (stage.bSkipped)
+			windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "STAGEGRAPH", "%s: skipped", stage.name.c_str());
+		else
+			windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "STAGEGRAPH", "%s: %.3fs", stage.name.c_str(), stage.seconds);
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "stdafx.h"
+#include "EngineStructs.h"
+#include <condition_variable>
+#include <deque>
+
+
+/****************************************************
+*													*
+*	StageGraph.h Runs the stages of a job on the	*
+*	ThreadPool. Every stage starts as soon as the	*
+*	stages it depends on are done, so stages that	*
+*	dont need each other overlap.					*
+*													*
+****************************************************/
+
+/**
+ * \brief Graph of stages with their dependencies. Add the stages, then run it once.
+ * A stage can run on a worker while all other workers are busy, so it never waits for a submitted task that might not start (parallelFor is fine)
+ */
+class StageGraph
+{
+public:
+
+	struct Stage
+	{
+		std::string name{};
+		std::vector<int> dependencies{};
+		//returns false if the stage failed, the stages that depend on it get skipped then
+		std::function<bool(Stage&)> func{};
+
+		//progress for the UI, the stage sets it while it runs
+		int64_t finishedItems = 0;
+		int64_t totalItems = 1;
+		CopyStatus status = CopyStatus::CS_idle;
+		//set by the stage if it failed
+		std::string errorMessage{};
+
+		bool bSkipped = false;
+		double seconds = 0;
+
+		//stages that depend on this one
+		std::vector<int> dependents{};
+		int missingDependencies = 0;
+	};
+
+private:
+
+	//deque so the progress references stay valid while stages get added
+	std::deque<Stage> stages{};
+
+	std::deque<int> readyStages{};
+	int finishedStages = 0;
+	//ThreadPool tasks that got submitted and didnt return yet, run waits for them so none outlives the graph
+	int pendingTasks = 0;
+	std::mutex stagesMutex;
+	std::condition_variable stagesCondition;
+
+	/**
+	 * \brief takes a ready stage and runs it, returns false if there was none
+	 */
+	bool runReadyStage();
+
+	/**
+	 * \brief DO NOT CALL WITHOUT THE LOCK! Marks the stage as finished and queues the dependents that are ready now
+	 * \return number of stages that got ready
+	 */
+	int finishStage(int index, bool bSuccess);
+
+	/**
+	 * \brief DO NOT CALL WITHOUT THE LOCK! Skips the stage and everything that depends on it
+	 */
+	void skipStage(int index);
+
+	/**
+	 * \brief submits a ThreadPool task for every stage that got ready
+	 */
+	void submitTasks(int count);
+
+public:
+
+	StageGraph() = default;
+
+	StageGraph(const StageGraph&) = delete;
+	StageGraph& operator=(const StageGraph&) = delete;
+
+	/**
+	 * \brief adds a stage, only before run
+	 * \param name name that shows up in the log and the UI
+	 * \param dependencies indexes of the stages that have to finish first
+	 * \param func the stage
+	 * \return index of the stage
+	 */
+	int addStage(const std::string& name, const std::vector<int>& dependencies, const std::function<bool(Stage&)>& func);
+
+	/**
+	 * \brief runs all stages and returns once every stage is done or skipped. The calling thread runs stages as well.
+	 * Running it again only runs the stages that didnt succeed yet, so a retry starts at the first stage that failed
+	 * \return true if every stage succeeded
+	 */
+	bool run();
+
+	const std::deque<Stage>& getStages() const { return stages; }
+
+	/**
+	 * \brief the first stage that failed, nullptr if none did
+	 */
+	const Stage* getFailedStage() const;
+
+	/**
+	 * \brief whether the stage succeeded, in this or an earlier run
+	 */
+	bool isStageDone(int index) const;
+
+	/**
+	 * \brief logs the time every stage took
+	 */
+	void logTimings() const;
+};
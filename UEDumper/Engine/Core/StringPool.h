@@ -0,0 +1,215 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <ostream>
+
+#include "ConcurrentMap.h"
+
+
+/****************************************************
+*													*
+*	StringPool.h Global pool of interned strings.	*
+*	Names that exist thousands of times in the		*
+*	packages (types, members, structs) are only		*
+*	stored once and referenced by a handle.			*
+*													*
+****************************************************/
+
+//number of strings per storage chunk of the pool
+#define STRINGPOOL_CHUNK_SIZE 4096
+
+//max number of chunks, the pool can hold STRINGPOOL_CHUNK_SIZE * STRINGPOOL_MAX_CHUNKS strings
+#define STRINGPOOL_MAX_CHUNKS 4096
+
+/**
+ * \brief Insert only pool of strings. Every distinct string gets a handle, handle 0 is always the empty string.
+ * Lookups by handle are lock free, interning a new string locks the pool. Strings are never freed.
+ */
+class StringPool
+{
+	struct PoolData
+	{
+		//storage of the strings, the chunks never move so references to the strings stay valid
+		std::atomic<std::string*> chunks[STRINGPOOL_MAX_CHUNKS]{};
+		std::atomic<uint32_t> count = 0;
+		//reverse lookup, the keys point into the storage
+		ConcurrentMap<std::string_view, uint32_t> handles{};
+		std::mutex writeMutex;
+	};
+
+	//function static, the pool can be used by other static initializers
+	static PoolData& getData()
+	{
+		static PoolData data;
+		return data;
+	}
+
+public:
+
+	/**
+	 * \brief returns the handle of the string, adds it to the pool if it is not in there yet
+	 * \param str the string
+	 * \return handle of the string
+	 */
+	static uint32_t intern(std::string_view str)
+	{
+		if (str.empty())
+			return 0;
+
+		PoolData& data = getData();
+		if (const auto handle = data.handles.find(str))
+			return *handle;
+
+		std::lock_guard lock(data.writeMutex);
+		if (const auto handle = data.handles.find(str))
+			return *handle;
+
+		const uint32_t index = data.count.load(std::memory_order_relaxed);
+		const uint32_t chunk = index / STRINGPOOL_CHUNK_SIZE;
+		if (chunk >= STRINGPOOL_MAX_CHUNKS)
+			throw std::runtime_error("string pool is full");
+
+		std::string* chunkPtr = data.chunks[chunk].load(std::memory_order_relaxed);
+		if (!chunkPtr)
+		{
+			chunkPtr = new std::string[STRINGPOOL_CHUNK_SIZE];
+			data.chunks[chunk].store(chunkPtr, std::memory_order_release);
+		}
+		std::string& stored = chunkPtr[index % STRINGPOOL_CHUNK_SIZE];
+		stored = str;
+		data.count.store(index + 1, std::memory_order_release);
+
+		//the handle gets published by the map, so everyone who has the handle can also read the string
+		const uint32_t handle = index + 1;
+		data.handles.insert(std::string_view(stored), handle);
+		return handle;
+	}
+
+	/**
+	 * \brief looks up the handle of a string without adding it to the pool
+	 * \param str the string
+	 * \param handle the handle if found
+	 * \return true if the string is in the pool
+	 */
+	static bool find(std::string_view str, uint32_t& handle)
+	{
+		if (str.empty())
+		{
+			handle = 0;
+			return true;
+		}
+		const auto found = getData().handles.find(str);
+		if (!found)
+			return false;
+		handle = *found;
+		return true;
+	}
+
+	/**
+	 * \brief returns the string for a handle
+	 * \param handle a handle returned by intern
+	 * \return the string, the reference stays valid forever
+	 */
+	static const std::string& get(uint32_t handle)
+	{
+		static const std::string empty;
+		if (handle == 0)
+			return empty;
+		const uint32_t index = handle - 1;
+		const std::string* chunkPtr = getData().chunks[index / STRINGPOOL_CHUNK_SIZE].load(std::memory_order_acquire);
+		return chunkPtr[index % STRINGPOOL_CHUNK_SIZE];
+	}
+
+	/**
+	 * \brief number of strings in the pool
+	 */
+	static size_t size()
+	{
+		return getData().count.load(std::memory_order_relaxed);
+	}
+};
+
+/**
+ * \brief Handle of a interned string. Equality and hashing only compare the handle, everything else behaves like a const std::string.
+ */
+class InternedString
+{
+	uint32_t handle = 0;
+
+public:
+
+	InternedString() = default;
+
+	InternedString(const std::string& str) : handle(StringPool::intern(str)) {}
+
+	InternedString(std::string_view str) : handle(StringPool::intern(str)) {}
+
+	InternedString(const char* str) : handle(StringPool::intern(str)) {}
+
+	/**
+	 * \brief returns the interned string for the given string without adding it to the pool
+	 * \param str the string
+	 * \param out the interned string if found
+	 * \return true if the string was interned before
+	 */
+	static bool find(std::string_view str, InternedString& out)
+	{
+		return StringPool::find(str, out.handle);
+	}
+
+	uint32_t getHandle() const { return handle; }
+
+	const std::string& str() const { return StringPool::get(handle); }
+
+	operator const std::string& () const { return str(); }
+
+	const char* c_str() const { return str().c_str(); }
+
+	const char* data() const { return str().data(); }
+
+	size_t size() const { return str().size(); }
+
+	size_t length() const { return str().length(); }
+
+	bool empty() const { return handle == 0; }
+
+	char operator[](size_t index) const { return str()[index]; }
+
+	InternedString& operator+=(const std::string& other)
+	{
+		handle = StringPool::intern(str() + other);
+		return *this;
+	}
+
+	bool operator==(const InternedString& other) const { return handle == other.handle; }
+
+	bool operator==(const std::string& other) const { return str() == other; }
+
+	bool operator==(const char* other) const { return str() == other; }
+
+	//sorting is still by the string so the generated output keeps its order
+	bool operator<(const InternedString& other) const { return handle != other.handle && str() < other.str(); }
+
+	friend std::string operator+(const InternedString& a, const std::string& b) { return a.str() + b; }
+	friend std::string operator+(const std::string& a, const InternedString& b) { return a + b.str(); }
+	friend std::string operator+(const InternedString& a, const char* b) { return a.str() + b; }
+	friend std::string operator+(const char* a, const InternedString& b) { return a + b.str(); }
+	friend std::string operator+(const InternedString& a, const InternedString& b) { return a.str() + b.str(); }
+	friend std::string operator+(const InternedString& a, char b) { return a.str() + b; }
+	friend std::string operator+(char a, const InternedString& b) { return a + b.str(); }
+
+	friend std::ostream& operator<<(std::ostream& os, const InternedString& str) { return os << str.str(); }
+};
+
+template <>
+struct std::hash<InternedString>
+{
+	size_t operator()(const InternedString& str) const noexcept
+	{
+		return str.getHandle();
+	}
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "ConcurrentMap.h"
+#include "StringPool.h"
+
+
+/****************************************************
+*													*
+*	SymbolTable.h Dense ids for the type names of	*
+*	the packages. Types resolve their name once		*
+*	when they get created, every later lookup of	*
+*	the ObjectInfo is a plain array index.			*
+*													*
+****************************************************/
+
+/**
+ * \brief Insert only table that gives every interned type name a dense id. Id 0 is reserved for "no symbol".
+ * Ids are handed out in the order the names are requested, they are only valid for the current process.
+ */
+class SymbolTable
+{
+	struct TableData
+	{
+		//linkage like following: string pool handle to symbol id
+		ConcurrentMap<uint32_t, uint32_t> ids{};
+		std::atomic<uint32_t> count = 0;
+		std::mutex writeMutex;
+	};
+
+	//function static, fieldTypes can get created by other static initializers
+	static TableData& getData()
+	{
+		static TableData data;
+		return data;
+	}
+
+public:
+
+	/**
+	 * \brief returns the id of the name, creates one if the name does not have an id yet. Thread safe
+	 * \param name the name
+	 * \return the symbol id, 0 for a empty name
+	 */
+	static uint32_t getId(const InternedString& name)
+	{
+		if (name.empty())
+			return 0;
+
+		TableData& data = getData();
+		if (const auto id = data.ids.find(name.getHandle()))
+			return *id;
+
+		std::lock_guard lock(data.writeMutex);
+		if (const auto id = data.ids.find(name.getHandle()))
+			return *id;
+
+		const uint32_t id = data.count.load(std::memory_order_relaxed) + 1;
+		data.ids.insert(name.getHandle(), id);
+		data.count.store(id, std::memory_order_release);
+		return id;
+	}
+
+	/**
+	 * \brief looks up the id of the name without creating one
+	 * \param name the name
+	 * \return the symbol id or 0 if the name has no id
+	 */
+	static uint32_t findId(const InternedString& name)
+	{
+		if (name.empty())
+			return 0;
+		const auto id = getData().ids.find(name.getHandle());
+		return id ? *id : 0;
+	}
+
+	/**
+	 * \brief number of ids, the highest id equals the size
+	 */
+	static size_t size()
+	{
+		return getData().count.load(std::memory_order_acquire);
+	}
+};
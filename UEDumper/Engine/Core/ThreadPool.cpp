@@ -0,0 +1,114 @@
+#include "ThreadPool.h"
+
+void ThreadPool::start()
+{
+	std::call_once(startFlag, []
+		{
+			state = new PoolState();
+			int workerCount = THREADPOOL_WORKER_CT;
+			if (workerCount <= 0)
+			{
+				const int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+				workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+			}
+			state->workerCount = workerCount;
+			//the workers live as long as the program
+			for (int i = 0; i < workerCount; i++)
+				std::thread(workerLoop).detach();
+		});
+}
+
+void ThreadPool::workerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock lock(state->tasksMutex);
+			state->tasksCondition.wait(lock, [] { return !state->tasks.empty(); });
+			task = std::move(state->tasks.front());
+			state->tasks.pop_front();
+		}
+		task();
+	}
+}
+
+int ThreadPool::getThreadCount()
+{
+	start();
+	return state->workerCount + 1;
+}
+
+std::future<void> ThreadPool::submit(const std::function<void()>& task)
+{
+	start();
+	auto packagedTask = std::make_shared<std::packaged_task<void()>>(task);
+	auto future = packagedTask->get_future();
+	{
+		std::lock_guard lock(state->tasksMutex);
+		state->tasks.emplace_back([packagedTask] { (*packagedTask)(); });
+	}
+	state->tasksCondition.notify_one();
+	return future;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t minRangeSize, const std::function<void(size_t, size_t)>& func)
+{
+	if (count == 0)
+		return;
+	if (minRangeSize == 0)
+		minRangeSize = 1;
+
+	//a few ranges per thread so uneven ranges even out
+	const size_t threadCount = getThreadCount();
+	size_t rangeSize = count / (threadCount * 4);
+	if (rangeSize < minRangeSize)
+		rangeSize = minRangeSize;
+	const size_t rangeCount = (count + rangeSize - 1) / rangeSize;
+
+	if (rangeCount == 1)
+	{
+		func(0, count);
+		return;
+	}
+
+	struct RangeState
+	{
+		std::atomic<size_t> nextRange = 0;
+		std::atomic<size_t> doneRanges = 0;
+		std::mutex doneMutex;
+		std::condition_variable doneCondition;
+	};
+	auto rangeState = std::make_shared<RangeState>();
+
+	//every thread takes ranges until none are left. Helpers that start too late just return
+	auto runRanges = [rangeState, rangeCount, rangeSize, count, &func]
+		{
+			size_t range;
+			while ((range = rangeState->nextRange.fetch_add(1)) < rangeCount)
+			{
+				const size_t start = range * rangeSize;
+				const size_t end = start + rangeSize < count ? start + rangeSize : count;
+				func(start, end);
+				if (rangeState->doneRanges.fetch_add(1) + 1 == rangeCount)
+				{
+					std::lock_guard lock(rangeState->doneMutex);
+					rangeState->doneCondition.notify_all();
+				}
+			}
+		};
+
+	const size_t helperCount = rangeCount - 1 < threadCount - 1 ? rangeCount - 1 : threadCount - 1;
+	{
+		std::lock_guard lock(state->tasksMutex);
+		for (size_t i = 0; i < helperCount; i++)
+			state->tasks.emplace_back(runRanges);
+	}
+	state->tasksCondition.notify_all();
+
+	runRanges();
+
+	//we only wait for ranges that other threads are working on right now, never for helpers that didnt start
+	std::unique_lock lock(rangeState->doneMutex);
+	rangeState->doneCondition.wait(lock, [&] { return rangeState->doneRanges.load() == rangeCount; });
+}
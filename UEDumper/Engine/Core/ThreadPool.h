@@ -0,0 +1,61 @@
+#pragma once
+
+#include "stdafx.h"
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+
+//number of worker threads, 0 uses one less than the number of hardware threads
+#define THREADPOOL_WORKER_CT 0
+
+/**
+ * \brief Small pool of worker threads for the dump. Work is either submitted as single task or split with parallelFor.
+ */
+class ThreadPool
+{
+	struct PoolState
+	{
+		int workerCount = 0;
+		std::deque<std::function<void()>> tasks{};
+		std::mutex tasksMutex;
+		std::condition_variable tasksCondition;
+	};
+
+	//never freed, the detached workers still use it while the statics get destroyed at exit
+	inline static PoolState* state = nullptr;
+	inline static std::once_flag startFlag;
+
+	/**
+	 * \brief starts the workers once
+	 */
+	static void start();
+
+	/**
+	 * \brief DO NOT CALL! Loop of every worker thread
+	 */
+	static void workerLoop();
+
+public:
+
+	/**
+	 * \brief number of threads that work on a parallelFor, including the calling thread
+	 */
+	static int getThreadCount();
+
+	/**
+	 * \brief runs the task on a worker thread
+	 * \param task the task
+	 * \return future that is ready once the task is done
+	 */
+	static std::future<void> submit(const std::function<void()>& task);
+
+	/**
+	 * \brief splits [0, count) into ranges and calls the function for every range on the workers and the calling thread.
+	 * Returns once every range is done. Safe to call from inside a task, the calling thread always helps.
+	 * \param count number of items
+	 * \param minRangeSize smallest range that gets handed to a thread
+	 * \param func function that gets the start and the end (exclusive) of a range
+	 */
+	static void parallelFor(size_t count, size_t minRangeSize, const std::function<void(size_t, size_t)>& func);
+};
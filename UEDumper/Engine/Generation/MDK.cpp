@@ -277,6 +277,7 @@ void MDKGeneration::generate(int& progressDone, int& totalProgress)
 	progressDone = 0;
 	totalProgress = 10;
 	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "MDK GEN", "Baking MDK...");
+	EngineCore::materializeAllStructs();
 
 	SDKPath = EngineSettings::getWorkingDirectory() / "MDK";
 	if (!create_directories(SDKPath))
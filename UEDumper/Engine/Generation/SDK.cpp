@@ -160,10 +160,10 @@ void SDKGeneration::generatePackage(
         }
     };
 
-    auto areAnyMembersUndefined = [&](EngineStructs::Member* member)
+    auto areAnyMembersUndefined = [&](const fieldType& memberType)
     {
-        bool anyUndef = !member->type.info || !member->type.info->valid;
-        if (!anyUndef && member->type.subTypes.size() > 0)
+        bool anyUndef = !memberType.info || !memberType.info->valid;
+        if (!anyUndef && memberType.subTypes.size() > 0)
         {
             auto checkAllSubs = [&](const fieldType& type, auto& self) -> void
                 {
@@ -183,7 +183,7 @@ void SDKGeneration::generatePackage(
                             self(sub, self);
                     }
                 };
-            checkAllSubs(member->type, checkAllSubs);
+            checkAllSubs(memberType, checkAllSubs);
         }
 
         return anyUndef;
@@ -273,10 +273,10 @@ void SDKGeneration::generatePackage(
                 std::vector<std::string> usedNames{};
 
                 int j = 0;
-                for (int i = 0; i < struc->cookedMembers.size(); i++)
+                const auto& layout = struc->layout;
+                for (size_t i = 0; i < layout.size(); i++)
                 {
-                    const auto member = struc->getMemberForIndex(i);
-                    std::string name = generateValidVarName(member->name, true);
+                    std::string name = generateValidVarName(layout.getName(i), true);
 
                     if (std::isdigit(name[0]))
                         name = "_" + name;
@@ -291,10 +291,10 @@ void SDKGeneration::generatePackage(
 
                     usedNames.push_back(name);
 
-                    if (areAnyMembersUndefined(member)) continue;
+                    if (areAnyMembersUndefined(layout.getType(i))) continue;
 
                     char buf[1024] = { 0 };
-                    sprintf_s(buf, "static_assert(offsetof(%s, %s) == 0x%04X);", klass.c_str(), name.c_str(), member->offset);
+                    sprintf_s(buf, "static_assert(offsetof(%s, %s) == 0x%04X);", klass.c_str(), name.c_str(), layout.offsets[i]);
                     stream << buf << std::endl;
                 }
             }
@@ -358,12 +358,13 @@ void SDKGeneration::generatePackage(
 
             int j = 0;
 
-            for (int i = 0; i < struc->cookedMembers.size(); i++)
+            const auto& layout = struc->layout;
+            for (size_t i = 0; i < layout.size(); i++)
             {
-                const auto member = struc->getMemberForIndex(i);
+                const auto& memberType = layout.getType(i);
                 char finalBuf[600];
                 char nameBuf[500];
-                std::string name = generateValidVarName(member->name, true);
+                std::string name = generateValidVarName(layout.getName(i), true);
 
                 if (name.empty())
                     name = "noname";
@@ -378,27 +379,27 @@ void SDKGeneration::generatePackage(
 
                 usedNames.push_back(name);
 
-                std::string memberType = member->type.stringify().c_str();
+                std::string memberTypeStr = memberType.stringify().c_str();
 
-                if (member->type.clickable && areAnyMembersUndefined(member))
+                if (memberType.clickable && areAnyMembersUndefined(memberType))
                 {
-                    memberType = "SDK_UNDEFINED(" + std::to_string(member->size) + "," + std::to_string(undefinedCnt++) + ") /* " + memberType + " */";
-                    name = "__um(" + member->name + ")";
-                } else if (member->arrayDim > 1) {
-                    name += "[" + std::to_string(member->arrayDim) + "]";
+                    memberTypeStr = "SDK_UNDEFINED(" + std::to_string(layout.sizes[i]) + "," + std::to_string(undefinedCnt++) + ") /* " + memberTypeStr + " */";
+                    name = "__um(" + layout.getName(i) + ")";
+                } else if (layout.arrayDims[i] > 1) {
+                    name += "[" + std::to_string(layout.arrayDims[i]) + "]";
                 }
 
-                if (member->isBit)
+                if (layout.isBit(i))
                     name += " : 1";
-                sprintf_s(nameBuf, "%-50s %s;", memberType.c_str(), name.c_str());
-                if (member->isBit)
-                    sprintf_s(finalBuf, "	%-110s // 0x%04X:%d (0x%04X) ", nameBuf, member->offset, member->bitOffset, member->size);
+                sprintf_s(nameBuf, "%-50s %s;", memberTypeStr.c_str(), name.c_str());
+                if (layout.isBit(i))
+                    sprintf_s(finalBuf, "	%-110s // 0x%04X:%d (0x%04X) ", nameBuf, layout.offsets[i], layout.bitOffsets[i], layout.sizes[i]);
                 else
-                    sprintf_s(finalBuf, "	%-110s // 0x%04X   (0x%04X) ", nameBuf, member->offset, member->size);
-                stream << finalBuf << " "; // << static_cast<int>(member->type.propertyType);
-                if (member->userEdited)
+                    sprintf_s(finalBuf, "	%-110s // 0x%04X   (0x%04X) ", nameBuf, layout.offsets[i], layout.sizes[i]);
+                stream << finalBuf << " "; // << static_cast<int>(memberType.propertyType);
+                if (layout.isUserEdited(i))
                     stream << "USER-MODIFIED";
-                else if (member->missed)
+                else if (layout.isMissed(i))
                     stream << "MISSED";
                 stream << std::endl;
             }
@@ -579,6 +580,7 @@ SDKGeneration::SDKGeneration()
 void SDKGeneration::Generate(int& progressDone, int& totalProgress, int featureFlags)
 {
     windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_INFO, "SDK GEN", "Baking SDK...");
+    EngineCore::materializeAllStructs();
 
     SDKPath = EngineSettings::getWorkingDirectory() / "SDK";
     if (!create_directories(SDKPath))
@@ -280,22 +280,22 @@ inline std::vector<MergedPackage*> sortPackages(int& progressDone, int& totalPro
 
 
 				//now we do the same check for every member
-				for (int i = 0; i < item->cookedMembers.size(); i++)
+				for (size_t i = 0; i < item->layout.size(); i++)
 				{
-					const auto member = item->getMemberForIndex(i);
+					const auto& memberType = item->layout.getType(i);
 					//if the member is not clickable its prob some bool or int
-					if (!member->type.clickable)
+					if (!memberType.clickable)
 						continue;
 
 
 					//these types are always pointers to classes or structs. They arent really a dependency as the compiler will know
 					//it will be 8 bytes large
-					if (member->type.propertyType == PropertyType::ObjectProperty || member->type.propertyType == PropertyType::ClassProperty)
+					if (memberType.propertyType == PropertyType::ObjectProperty || memberType.propertyType == PropertyType::ClassProperty)
 						continue;
 
 					//is the type a unknown type? Nothing we can do about it, SDK will handle it via macro (see SDK_UNDEFINED in SDK.cpp)
 					//unknown type means info.valid is false
-					auto info = member->type.info;
+					auto info = memberType.info;
 					if (!info || !info->valid)
 						continue;
 
@@ -309,7 +309,7 @@ inline std::vector<MergedPackage*> sortPackages(int& progressDone, int& totalPro
 						fixOrder(typeItem);
 					}
 
-					for (auto& sub : member->type.subTypes)
+					for (auto& sub : memberType.subTypes)
 					{
 						auto subInfo = sub.info;
 						if (!subInfo || !subInfo->valid)
@@ -0,0 +1,145 @@
+#include "ObjectWatcher.h"
+
+#include "Engine/Core/ObjectsManager.h"
+#include "Frontend/Windows/LogWindow.h"
+
+std::pair<int, int> ObjectWatcher::processItems(int32_t start, const std::vector<FUObjectItem>& items, std::vector<uint64_t>& newObjects, std::vector<uint64_t>& deadObjects)
+{
+	int created = 0;
+	int destroyed = 0;
+	for (int32_t i = 0; i < static_cast<int32_t>(items.size()); i++)
+	{
+		uint64_t& known = knownObjects[start + i];
+		const uint64_t current = items[i].Object;
+		if (known == current)
+			continue;
+
+		//the slot had a object before, that one is gone now
+		if (known)
+		{
+			deadObjects.push_back(known);
+			destroyed++;
+		}
+		//a new object got placed in the slot
+		if (current)
+		{
+			newObjects.push_back(current);
+			created++;
+		}
+		known = current;
+	}
+	return { created, destroyed };
+}
+
+void ObjectWatcher::watcherLoop()
+{
+	windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "WATCHER", "Started object watcher!");
+
+	ObjectsManager::TypeUObjectArray objectArray{};
+	if (!ObjectsManager::readLiveObjectArray(objectArray))
+	{
+		windows::LogWindow::Log(windows::LogWindow::logLevels::LOGLEVEL_WARNING, "WATCHER", "Could not read the object array, stopping the watcher!");
+		running = false;
+		return;
+	}
+
+	std::vector<FUObjectItem> items;
+	std::vector<uint64_t> newObjects;
+	std::vector<uint64_t> deadObjects;
+
+	//initial snapshot, everything that exists now is not counted as created
+	ObjectsManager::readFUObjectItems(0, objectArray.NumElements, items);
+	knownObjects.resize(objectArray.NumElements, 0);
+	for (int32_t i = 0; i < objectArray.NumElements; i++)
+		knownObjects[i] = items[i].Object;
+
+	auto windowStart = std::chrono::steady_clock::now();
+	int64_t windowCreated = 0;
+	int64_t windowDestroyed = 0;
+
+	while (true)
+	{
+		Sleep(OBJECT_WATCHER_SPEED);
+
+		if (!ObjectsManager::readLiveObjectArray(objectArray))
+			continue;
+
+		newObjects.clear();
+		deadObjects.clear();
+
+		const int32_t knownCount = static_cast<int32_t>(knownObjects.size());
+		int created = 0;
+		int destroyed = 0;
+
+		//new range, the array only ever grows
+		if (objectArray.NumElements > knownCount && ObjectsManager::readFUObjectItems(knownCount, objectArray.NumElements - knownCount, items))
+		{
+			knownObjects.resize(objectArray.NumElements, 0);
+			const auto [c, d] = processItems(knownCount, items, newObjects, deadObjects);
+			created += c;
+			destroyed += d;
+		}
+
+		//sweep over a part of the known range to find destroyed objects and reused slots
+		if (knownCount > 0)
+		{
+			if (sweepIndex >= knownCount)
+				sweepIndex = 0;
+			const int32_t sweepCount = knownCount - sweepIndex < OBJECT_WATCHER_SWEEP_ITEMS ? knownCount - sweepIndex : OBJECT_WATCHER_SWEEP_ITEMS;
+			if (ObjectsManager::readFUObjectItems(sweepIndex, sweepCount, items))
+			{
+				const auto [c, d] = processItems(sweepIndex, items, newObjects, deadObjects);
+				created += c;
+				destroyed += d;
+			}
+			sweepIndex += sweepCount;
+		}
+
+		if (!deadObjects.empty())
+			ObjectsManager::invalidateRuntimeObjects(deadObjects);
+
+		if (newObjects.size() > OBJECT_WATCHER_MAX_PREFETCH)
+			newObjects.resize(OBJECT_WATCHER_MAX_PREFETCH);
+		ObjectsManager::prefetchRuntimeObjects(newObjects);
+
+		windowCreated += created;
+		windowDestroyed += destroyed;
+
+		std::lock_guard lock(statsMutex);
+		stats.numElements = objectArray.NumElements;
+		stats.created += created;
+		stats.destroyed += destroyed;
+
+		const auto now = std::chrono::steady_clock::now();
+		const auto windowMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - windowStart).count();
+		if (windowMs >= 1000)
+		{
+			stats.createdPerSecond = static_cast<float>(windowCreated) * 1000.f / static_cast<float>(windowMs);
+			stats.destroyedPerSecond = static_cast<float>(windowDestroyed) * 1000.f / static_cast<float>(windowMs);
+			windowCreated = 0;
+			windowDestroyed = 0;
+			windowStart = now;
+		}
+	}
+}
+
+void ObjectWatcher::startWatching()
+{
+#if OBJECT_WATCHER_ENABLED
+	if (running.exchange(true))
+		return;
+
+	CreateThread(nullptr, 0, reinterpret_cast<LPTHREAD_START_ROUTINE>(watcherLoop), nullptr, 0, nullptr);
+#endif
+}
+
+bool ObjectWatcher::isRunning()
+{
+	return running;
+}
+
+ObjectWatcher::Stats ObjectWatcher::getStats()
+{
+	std::lock_guard lock(statsMutex);
+	return stats;
+}
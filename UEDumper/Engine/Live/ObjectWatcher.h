@@ -0,0 +1,71 @@
+#pragma once
+
+#include "stdafx.h"
+#include "Engine/structs.h"
+
+//whether the object watcher gets started together with the live editor
+#define OBJECT_WATCHER_ENABLED TRUE
+
+//delay between every poll of the games object array in ms
+#define OBJECT_WATCHER_SPEED 250
+
+//number of already known FUObjectItems that get read again every poll to find destroyed or reused slots
+#define OBJECT_WATCHER_SWEEP_ITEMS (16 * 1024)
+
+//max number of new objects that get prefetched into the runtime cache per poll
+#define OBJECT_WATCHER_MAX_PREFETCH 4096
+
+/**
+ * \brief Background watcher for the games object array. Polls NumElements and the chunk table,
+ * reads only the new and a sweep of the known FUObjectItems and prefetches new objects into the runtime cache.
+ */
+class ObjectWatcher
+{
+public:
+	struct Stats
+	{
+		//NumElements at the latest poll
+		int32_t numElements = 0;
+		//objects seen since the watcher started
+		int64_t created = 0;
+		int64_t destroyed = 0;
+		//rates of the latest second
+		float createdPerSecond = 0;
+		float destroyedPerSecond = 0;
+	};
+
+private:
+
+	//object pointer of every index we know, only touched by the watcher thread
+	static inline std::vector<uint64_t> knownObjects{};
+
+	//next index of the sweep over the known objects
+	static inline int32_t sweepIndex = 0;
+
+	static inline std::atomic<bool> running = false;
+
+	static inline std::mutex statsMutex;
+	static inline Stats stats{};
+
+	/**
+	 * \brief DO NOT CALL! Function that polls the object array
+	 */
+	static void watcherLoop();
+
+	/**
+	 * \brief compares the items with the known objects starting at the given index and collects the changes
+	 * \return number of created and destroyed objects
+	 */
+	static std::pair<int, int> processItems(int32_t start, const std::vector<FUObjectItem>& items, std::vector<uint64_t>& newObjects, std::vector<uint64_t>& deadObjects);
+
+public:
+
+	/**
+	 * \brief starts the watcher thread once. Call after the SDK generation is done
+	 */
+	static void startWatching();
+
+	static bool isRunning();
+
+	static Stats getStats();
+};
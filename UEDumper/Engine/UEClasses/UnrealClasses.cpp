@@ -272,6 +272,10 @@ UClass* UStruct::staticClass()
 
 std::vector<TPair<FName, int64_t>> UEnum::getNames() const
 {
+    //got read in a batch before?
+    if (const auto names = ObjectsManager::getCachedEnumNames(objectptr))
+        return *names;
+
     std::vector<TPair<FName, int64_t>> vec(Names.Count);
 
     Memory::read(Names.Data, vec.data(), sizeof(TPair<FName, int64_t>) * Names.Count);
@@ -0,0 +1,31 @@
+#pragma once
+#include "stdafx.h"
+
+/****************************************************
+*													*
+*	PackageFilter.h - Choose the packages that get	*
+*	dumped. Leave both lists empty to dump every	*
+*	package like before.							*
+*													*
+****************************************************/
+
+/// - the names are the package names like they show up in the package viewer, e.g. "Engine", "CoreUObject" or "MyGame"
+/// - * matches any amount of characters, ? matches exactly one. e.g. "Niagara*" matches every niagara package
+/// - a package gets dumped if it matches any include (or the include list is empty) and no exclude
+/// - excluded packages still get dumped if a dumped package needs one of their structs or enums by value
+///   (supers, members, subtypes). Types that are only used as pointers never pull in a package.
+///   Disable PACKAGE_FILTER_PULL_DEPENDENCIES and these types stay undefined, the SDK emits them as blobs with the right size.
+
+//whether excluded packages get dumped anyways if a dumped package needs their types
+#define PACKAGE_FILTER_PULL_DEPENDENCIES TRUE
+
+//packages that get dumped, empty means all
+inline const std::vector<std::string> includedPackages = {
+	//"CoreUObject",
+	//"Engine",
+};
+
+//packages that never get dumped on their own
+inline const std::vector<std::string> excludedPackages = {
+	//"Niagara*",
+};
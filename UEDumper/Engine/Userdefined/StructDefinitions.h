@@ -351,7 +351,7 @@ inline void addEnums()
 	EobjectFlags.cppName = "EObjectFlags";
 	EobjectFlags.size = sizeof(EObjectFlags);
 	EobjectFlags.type = TYPE_UI32;
-	EobjectFlags.members = std::vector<std::pair<std::string, int>>{
+	EobjectFlags.members = std::vector<std::pair<InternedString, int>>{
 		{"RF_NoFlags", RF_NoFlags},
 		{"RF_Public", RF_Public},
 		{"RF_Standalone", RF_Standalone},
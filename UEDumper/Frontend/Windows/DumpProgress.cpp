@@ -5,6 +5,7 @@
 #include <Engine/Core/ObjectsManager.h>
 #include <Settings/EngineSettings.h>
 
+#include "Engine/Core/StageGraph.h"
 #include "Frontend/IGHelper.h"
 #include "Frontend/Texture/TextureCreator.h"
 #include "Memory/memory.h"
@@ -19,96 +20,183 @@ bool windows::DumpProgress::render()
 	if (bAlreadyCompleted) return true;
 
 	//statics
-	static dumpProgress GObjectPtrs{};
-	static dumpProgress UBigObjects{};
-	static dumpProgress FNames{};
-	static dumpProgress packages{};
+	static StageGraph dumpStages{};
+#if USE_DUMP_PIPELINE
+	static BoundedQueue<ObjectChunk> copiedChunks(PIPELINE_QUEUE_CAPACITY);
+#endif
 
 	static uint64_t startDumpTime = 0;
 
 	static bool callOnce = false;
 	static bool errorOccurred = false;
+	static bool bCancelled = false;
 	static std::string errorMessage = "";
 
+	//both ends of the object queue, with the pipeline they have to run together
+	static int uBigObjectsStage = -1;
+	static int fNamesStage = -1;
+
+	//runs every stage that is not done yet, the first time all of them
+	static const auto runDump = []
+	{
+		bIsBusy = true;
+		LogWindow::Log(LogWindow::logLevels::LOGLEVEL_INFO, "DUMPPROGRESS", "Starting dump...");
+		startDumpTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+#if USE_DUMP_PIPELINE
+		copiedChunks.reset();
+#endif
+
+		const bool bSuccess = dumpStages.run();
+		dumpStages.logTimings();
+
+		if (!bSuccess)
+		{
+			bCancelled = ObjectsManager::getCancellationToken().isCancelled();
+			const auto failedStage = dumpStages.getFailedStage();
+			errorMessage = failedStage->errorMessage.empty() ? LogWindow::getLastLogMessage() : failedStage->errorMessage;
+			errorOccurred = true;
+			return;
+		}
+		//a cancel that came after the last check must not stop the live editor
+		ObjectsManager::getCancellationToken().reset();
+
+		LogWindow::Log(LogWindow::logLevels::LOGLEVEL_INFO, "DUMPPROGRESS", "Finished dumping!");
+		//we're done
+		bAlreadyCompleted = true;
+		bIsBusy = false;
+		LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "DUMPPROGRESS", "Finished everything with %d memory operations!", Memory::getTotalReads());
+
+		ObjectsManager::setSDKGenerationDone();
+		EngineSettings::setLiveEditor(true);
+	};
+
 	//async job that gets called once
 	if(!callOnce)
 	{
 		callOnce = true;
-		//unique pointer using future so the render function can return without waiting for the async thread to complete
-		std::make_unique<std::future<void>*>(new auto(std::async(std::launch::async, [] {
-			bIsBusy = true;
-			LogWindow::Log(LogWindow::logLevels::LOGLEVEL_INFO, "DUMPPROGRESS", "Starting dump...");
-			startDumpTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-
-			EngineCore();
-
-			if (!EngineCore::initSuccess()) {
-				errorMessage = LogWindow::getLastLogMessage();
-				LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "Failed to initialize EngineCore!");
-				errorOccurred = true;
-				return;
-			}
 
-			ObjectsManager();
+		//the name table and the objects dont need each other, only the object names need both
+		const int offsetsStage = dumpStages.addStage("Reading offsets", {}, [](StageGraph::Stage&)
+			{
+				EngineCore::loadOffsets();
+				return true;
+			});
 
-			if (ObjectsManager::CRITICAL_STOP_CALLED()) {
-				LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "Failed to initialize EngineCore!");
-				errorOccurred = true;
-				errorMessage = ObjectsManager::getErrorMessage();
-				return;
-			}
-			
-			ObjectsManager::copyGObjectPtrs(GObjectPtrs.finishedBytes, GObjectPtrs.totalBytes, GObjectPtrs.status);
-			
+		const int engineCoreStage = dumpStages.addStage("Loading EngineCore", { offsetsStage }, [](StageGraph::Stage& stage)
+			{
+				EngineCore();
+				if (!EngineCore::initSuccess())
+				{
+					stage.errorMessage = LogWindow::getLastLogMessage();
+					LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "Failed to initialize EngineCore!");
+					return false;
+				}
+				return true;
+			});
 
-			if (GObjectPtrs.status != CopyStatus::CS_success || ObjectsManager::CRITICAL_STOP_CALLED())
+		const int namePoolStage = dumpStages.addStage("Reading the name table", { engineCoreStage }, [](StageGraph::Stage& stage)
 			{
-				LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "No success at copyGObjectPtrs!");
-				errorOccurred = true;
-				errorMessage = ObjectsManager::getErrorMessage();
-				return;
-			}
-				
-			
-			ObjectsManager::copyUBigObjects(UBigObjects.finishedBytes, UBigObjects.totalBytes, UBigObjects.status);
-			if (UBigObjects.status != CopyStatus::CS_success || ObjectsManager::CRITICAL_STOP_CALLED())
+				EngineCore::loadNamePool(stage.finishedItems, stage.totalItems, stage.status);
+				return stage.status == CopyStatus::CS_success;
+			});
+
+		const int objectsManagerStage = dumpStages.addStage("Loading ObjectsManager", { offsetsStage }, [](StageGraph::Stage& stage)
 			{
-				LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "No success at copyUBigObjects!");
-				errorOccurred = true;
-				errorMessage = ObjectsManager::getErrorMessage();
-				return;
-			}
-			EngineCore::cacheFNames(FNames.finishedBytes, FNames.totalBytes, FNames.status);
-			if (FNames.status != CopyStatus::CS_success || ObjectsManager::CRITICAL_STOP_CALLED())
+				ObjectsManager();
+				if (ObjectsManager::CRITICAL_STOP_CALLED())
+				{
+					stage.errorMessage = ObjectsManager::getErrorMessage();
+					LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "Failed to initialize ObjectsManager!");
+					return false;
+				}
+				return true;
+			});
+
+		const int gObjectPtrsStage = dumpStages.addStage("Caching gObject Pointers", { objectsManagerStage }, [](StageGraph::Stage& stage)
 			{
-				LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "No success at caching FNames!");
-				errorOccurred = true;
-				errorMessage = LogWindow::getLastLogMessage();
-				return;
-			}
-			EngineCore::generatePackages(packages.finishedBytes, packages.totalBytes, packages.status);
-			if (packages.status != CopyStatus::CS_success || ObjectsManager::CRITICAL_STOP_CALLED())
+				ObjectsManager::copyGObjectPtrs(stage.finishedItems, stage.totalItems, stage.status);
+				if (stage.status != CopyStatus::CS_success || ObjectsManager::CRITICAL_STOP_CALLED())
+				{
+					stage.errorMessage = ObjectsManager::getErrorMessage();
+					LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "No success at copyGObjectPtrs!");
+					return false;
+				}
+				return true;
+			});
+
+#if USE_DUMP_PIPELINE
+		//the objects get copied while the FName caching takes every copied chunk. Both ends of the queue have to run
+		//at the same time, so both wait for the name table. The copy cant get further ahead than the queue capacity anyways.
+		//If one end is done from an earlier try, the other one works without the queue
+		const std::vector<int> uBigObjectsDependencies = { gObjectPtrsStage, namePoolStage };
+		static const auto getChunks = []() -> BoundedQueue<ObjectChunk>*
+		{
+			return dumpStages.isStageDone(uBigObjectsStage) || dumpStages.isStageDone(fNamesStage) ? nullptr : &copiedChunks;
+		};
+#else
+		const std::vector<int> uBigObjectsDependencies = { gObjectPtrsStage };
+		static const auto getChunks = []() -> BoundedQueue<ObjectChunk>* { return nullptr; };
+#endif
+		uBigObjectsStage = dumpStages.addStage("Caching UBigObjects", uBigObjectsDependencies, [](StageGraph::Stage& stage)
 			{
-				errorMessage = LogWindow::getLastLogMessage();
-				LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "No success at generating Packages!");
-				errorOccurred = true;
-				return;
-			}
-			LogWindow::Log(LogWindow::logLevels::LOGLEVEL_INFO, "DUMPPROGRESS", "Finished dumping!");
-			//we're done
-			bAlreadyCompleted = true;
-			bIsBusy = false;
-			LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ONLY_LOG, "DUMPPROGRESS", "Finished everything with %d memory operations!", Memory::getTotalReads());
+				ObjectsManager::copyUBigObjects(stage.finishedItems, stage.totalItems, stage.status, getChunks());
+				if (stage.status != CopyStatus::CS_success || ObjectsManager::CRITICAL_STOP_CALLED())
+				{
+					stage.errorMessage = ObjectsManager::getErrorMessage();
+					LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "No success at copyUBigObjects!");
+					return false;
+				}
+				return true;
+			});
 
-			ObjectsManager::setSDKGenerationDone();
-			EngineSettings::setLiveEditor(true);
+#if USE_DUMP_PIPELINE
+		const std::vector<int> fNamesDependencies = { gObjectPtrsStage, namePoolStage };
+#else
+		const std::vector<int> fNamesDependencies = { uBigObjectsStage, namePoolStage };
+#endif
+		fNamesStage = dumpStages.addStage("Caching FNames", fNamesDependencies, [](StageGraph::Stage& stage)
+			{
+				EngineCore::cacheFNames(stage.finishedItems, stage.totalItems, stage.status, getChunks());
+				if (stage.status != CopyStatus::CS_success || ObjectsManager::CRITICAL_STOP_CALLED())
+				{
+					stage.errorMessage = LogWindow::getLastLogMessage();
+					LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "No success at caching FNames!");
+					return false;
+				}
+				return true;
+			});
 
-		}))).reset();
+#if USE_DUMP_CHECKPOINTS
+		//both ends of the queue grow the objects, the checkpoint waits for them. The packages grow them too, so they wait for the checkpoint
+		const int objectCheckpointStage = dumpStages.addStage("Saving the UBigObjects checkpoint", { uBigObjectsStage, fNamesStage }, [](StageGraph::Stage&)
+			{
+				//without the checkpoint the next dump just copies everything again
+				ObjectsManager::saveObjectCheckpoint();
+				return true;
+			});
+		const std::vector<int> packagesDependencies = { uBigObjectsStage, fNamesStage, objectCheckpointStage };
+#else
+		const std::vector<int> packagesDependencies = { uBigObjectsStage, fNamesStage };
+#endif
+		dumpStages.addStage("Caching Packages", packagesDependencies, [](StageGraph::Stage& stage)
+			{
+				EngineCore::generatePackages(stage.finishedItems, stage.totalItems, stage.status);
+				if (stage.status != CopyStatus::CS_success || ObjectsManager::CRITICAL_STOP_CALLED())
+				{
+					stage.errorMessage = LogWindow::getLastLogMessage();
+					LogWindow::Log(LogWindow::logLevels::LOGLEVEL_ERROR, "DUMPPROGRESS", "No success at generating Packages!");
+					return false;
+				}
+				return true;
+			});
+
+		//unique pointer using future so the render function can return without waiting for the async thread to complete
+		std::make_unique<std::future<void>*>(new auto(std::async(std::launch::async, runDump))).reset();
 	}
 
 	const ImVec2 bigWindow = IGHelper::getWindowSize();
 
-	constexpr auto childSize = ImVec2(600, 240);
+	constexpr auto childSize = ImVec2(600, 300);
 	ImGui::SetCursorPos(ImVec2(bigWindow.x / 2 - childSize.x / 2, bigWindow.y / 2 - childSize.y / 2));
 
 	ImGui::BeginChild("DumpingChild", childSize, true, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollWithMouse);
@@ -121,10 +209,26 @@ bool windows::DumpProgress::render()
 		ImGui::Image(TextureCreator::getTexture("warninglogo"), ImVec2(150, 150));
 		ImGui::SameLine();
 		ImGui::BeginChild("ObjectsManagerTopMostCallbackChild", ImVec2(380, 150), false, ImGuiWindowFlags_NoScrollWithMouse);
-		ImGui::TextWrapped("Sorry! You ran into a unrecoverable error that forces the Dumper to close.");
-		ImGui::TextWrapped(errorMessage.c_str());
+		if (bCancelled)
+			ImGui::TextWrapped("The dump got cancelled.");
+		else
+		{
+			ImGui::TextWrapped("Sorry! You ran into an error.");
+			ImGui::TextWrapped(errorMessage.c_str());
+		}
+		ImGui::TextWrapped("Retry goes on with the first stage that is not done yet.");
 		ImGui::EndChild();
-		ImGui::Dummy(ImVec2(ImGui::GetWindowSize().x / 2 - 65, 0));
+		ImGui::Dummy(ImVec2(ImGui::GetWindowSize().x / 2 - 115, 0));
+		ImGui::SameLine();
+		if (ImGui::Button("Retry", ImVec2(90, 40)))
+		{
+			ObjectsManager::resolvedStop();
+			ObjectsManager::getCancellationToken().reset();
+			bCancelled = false;
+			errorOccurred = false;
+			errorMessage.clear();
+			std::make_unique<std::future<void>*>(new auto(std::async(std::launch::async, runDump))).reset();
+		}
 		ImGui::SameLine();
 		if (ImGui::Button("Exit", ImVec2(90, 40)))
 		{
@@ -142,42 +246,36 @@ bool windows::DumpProgress::render()
 		ImGui::Text("Dump in progress %s", timeStr.str().c_str());
 		ImGui::SameLine();
 		ImGui::Spinner();
-		float progress;
 
-		if(GObjectPtrs.status != CopyStatus::CS_success && GObjectPtrs.status == CopyStatus::CS_busy)
+		//every stage that runs right now, there can be a few at once
+		bool bAnyBusy = false;
+		for (const auto& stage : dumpStages.getStages())
 		{
-			progress = static_cast<float>(GObjectPtrs.finishedBytes) / GObjectPtrs.totalBytes;
-			ImGui::Text("Caching gObject Pointers (%06lld/%06lld)", GObjectPtrs.finishedBytes, GObjectPtrs.totalBytes);
-			
-		}
-		else if (UBigObjects.status != CopyStatus::CS_success && UBigObjects.status == CopyStatus::CS_busy)
-		{
-			progress = static_cast<float>(UBigObjects.finishedBytes) / UBigObjects.totalBytes;
-			ImGui::Text("Caching UBigObjects (%06lld/%06lld)", UBigObjects.finishedBytes, UBigObjects.totalBytes);
-		}
-		else if (FNames.status != CopyStatus::CS_success && FNames.status == CopyStatus::CS_busy)
-		{
-			progress = static_cast<float>(FNames.finishedBytes) / FNames.totalBytes;
-			ImGui::Text("Caching FNames (%06lld/%06lld)", FNames.finishedBytes, FNames.totalBytes);
-		}
-		else if (packages.status != CopyStatus::CS_success && packages.status == CopyStatus::CS_busy)
-		{
-			progress = static_cast<float>(packages.finishedBytes) / packages.totalBytes;
-			ImGui::Text("Caching Packages (%03lld/%03lld)", packages.finishedBytes, packages.totalBytes);
+			if (stage.status != CopyStatus::CS_busy)
+				continue;
+			bAnyBusy = true;
+			//stages without own progress only show their name
+			if (stage.totalItems <= 1)
+			{
+				ImGui::Text("%s...", stage.name.c_str());
+				continue;
+			}
+			ImGui::Text("%s (%06lld/%06lld)", stage.name.c_str(), stage.finishedItems, stage.totalItems);
+			ImGui::ProgressBar(static_cast<float>(stage.finishedItems) / stage.totalItems, ImVec2(480, 20));
 		}
-		else
-		{
+		if (!bAnyBusy)
 			ImGui::Text("Initializing...");
-			//no progress bar if status is unknown
-			goto skip;
-		}
 
+		ImGui::TextWrapped(LogWindow::getLastLogMessage().c_str());
 
-		ImGui::ProgressBar(progress, ImVec2(480, 30));
-		skip: {
-			//-
+		//the stages stop at their next check, the finished ones stay done for a retry
+		if (ObjectsManager::getCancellationToken().isCancelled())
+			ImGui::Text("Cancelling...");
+		else if (ImGui::Button("Cancel", ImVec2(90, 30)))
+		{
+			LogWindow::Log(LogWindow::logLevels::LOGLEVEL_INFO, "DUMPPROGRESS", "Cancelling the dump...");
+			ObjectsManager::getCancellationToken().cancel();
 		}
-		ImGui::TextWrapped(LogWindow::getLastLogMessage().c_str());
 	}
 	ImGui::EndChild();
 	return false;
@@ -12,14 +12,6 @@ namespace windows
 		static inline bool bIsBusy = false;
 
 
-		struct dumpProgress
-		{
-			int64_t finishedBytes = 0;
-			int64_t totalBytes = 1;
-			CopyStatus status = CopyStatus::CS_idle;
-		};
-
-
 	public:
 		DumpProgress();
 
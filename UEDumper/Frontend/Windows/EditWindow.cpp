@@ -283,6 +283,10 @@ void windows::EditWindow::renderEditBit()
             edit.editMember->name = std::string(tempNewNameBuf);
             edit.editMember->userEdited = true;
 			edit.editMember->type.name = isBool ? "bool" : "unsigned char";
+			//the layout has copies of the member and its pooled type. Recooking would generate the unknown bits again
+			//and lose the name, so only the layout gets packed again
+			edit.editMember->internType();
+			edit.editStruct->buildLayout();
 
             LogWindow::Log(LogWindow::logLevels::LOGLEVEL_INFO, "PACKAGEVIEWER", "Named unknown object to %s!", tempNewNameBuf);
             memset(tempNewNameBuf, 0, sizeof(tempNewNameBuf));
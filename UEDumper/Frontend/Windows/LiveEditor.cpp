@@ -3,6 +3,7 @@
 #include "LogWindow.h"
 #include "Engine/Core/Core.h"
 #include "Engine/Live/LiveMemory.h"
+#include "Engine/Live/ObjectWatcher.h"
 #include "Engine/UEClasses/UnrealClasses.h"
 #include "Frontend/IGHelper.h"
 #include "Frontend/StrucGraph.h"
@@ -82,6 +83,7 @@ void windows::LiveEditor::renderAddAddress()
 			}
 
 			tab.struc = static_cast<EngineStructs::Struct*>(info->target);
+			EngineCore::materializeStruct(tab.struc);
 			tab.isClass = info->type == ObjectInfo::OI_Class;
 
 			tab.found = true;
@@ -223,6 +225,7 @@ void windows::LiveEditor::renderAddOffset()
 					goto failed;
 				}
 				tab.struc = static_cast<EngineStructs::Struct*>(info->target);
+				EngineCore::materializeStruct(tab.struc);
 
 				tab.isClass = info->type == ObjectInfo::OI_Class;
 
@@ -908,13 +911,16 @@ void windows::LiveEditor::drawMembers(const EngineStructs::Struct* struc, uint64
 	//draw the secret for debug purposes.
 	//ImGui::TextColored(IGHelper::Colors::grayedOut, secret.c_str());
 
-	//iterate through all the members of the struct
-	for (const auto& member : struc->definedMembers)
+	//iterate through all the members of the struct in cooked order
+	const auto& layout = struc->layout;
+	for (size_t i = 0; i < layout.size(); i++)
 	{
-		//ignore missed members
-		if (member.missed)
+		//ignore padding, unknown and missed members
+		if (!layout.isDefined(i) || layout.isMissed(i))
 			continue;
 
+		const auto& member = *struc->getMemberForIndex(i);
+
 		//get the current cursor pos so we can use it below
 		const auto posX = ImGui::GetCursorPosX();
 		//also draw the bit if it is one
@@ -970,7 +976,7 @@ void windows::LiveEditor::drawMembers(const EngineStructs::Struct* struc, uint64
 				ImGui::TextColored(IGHelper::Colors::varPink, member.name.c_str());
 				ImGui::SameLine();
 				//read the fname and show it
-				ImGui::TextColored(IGHelper::Colors::stringRed, EngineCore::FNameToString(block->read<FName>(member.offset + innerOffset)).c_str());
+				ImGui::TextColored(IGHelper::Colors::stringRed, EngineCore::FNameToStringView(block->read<FName>(member.offset + innerOffset)).data());
 				break;
 
 				//TEnumAsByte support
@@ -1121,7 +1127,7 @@ bool windows::LiveEditor::isValidStructName(uint64_t classPointer, const std::st
 			//we cannot use enginecores functions because some objets arent in the object list generated
 			//for the SDK! So we have to do it all here and (most likely) read data multiple times
 			const auto obj = ObjectsManager::getUObject<UObject>(classPointer);
-			if (obj->getClass())
+			if (obj && obj->getClass())
 				superName = obj->getClass()->getCName();
 		}
 		if (superName == "nil" || superName.empty())
@@ -1132,6 +1138,7 @@ bool windows::LiveEditor::isValidStructName(uint64_t classPointer, const std::st
 			goto tryAgain;
 
 		outStruct = static_cast<EngineStructs::Struct*>(info->target);
+		EngineCore::materializeStruct(outStruct);
 
 		//found it! Adding...
 		if (!found)
@@ -1145,6 +1152,7 @@ tryAgain:
 		return false;
 
 	outStruct = static_cast<EngineStructs::Struct*>(info->target);
+	EngineCore::materializeStruct(outStruct);
 
 	return true;
 }
@@ -1201,6 +1209,7 @@ bool windows::LiveEditor::renderLaunchPopup()
 	if (ImGui::Button("Continue", ImVec2(120, 30)))
 	{
 		LiveMemory::cacheBlocks();
+		ObjectWatcher::startWatching();
 		liveEditorStarted = true;
 		accepted = true;
 		ImGui::End();
@@ -1264,7 +1273,9 @@ void windows::LiveEditor::renderLiveEditor()
 		if (ImGui::Button("Search for class/member"))
 			bRenderSearchBox = true;
 
-	if (ImGui::BeginListBox("##liveInspectorList", ImVec2(ImGui::GetWindowSize().x - 15, ImGui::GetWindowSize().y - 50)))
+	//leave space for the object watcher stats below the list
+	const float listBoxYSize = ImGui::GetWindowSize().y - (ObjectWatcher::isRunning() ? 75 : 50);
+	if (ImGui::BeginListBox("##liveInspectorList", ImVec2(ImGui::GetWindowSize().x - 15, listBoxYSize)))
 	{
 
 		for (int i = 0; i < tabs.size(); i++)
@@ -1284,6 +1295,11 @@ void windows::LiveEditor::renderLiveEditor()
 		}
 		ImGui::EndListBox();
 	}
+	if (ObjectWatcher::isRunning())
+	{
+		const auto stats = ObjectWatcher::getStats();
+		ImGui::Text("Objects: %d  +%.1f/s  -%.1f/s", stats.numElements, stats.createdPerSecond, stats.destroyedPerSecond);
+	}
 	ImGui::EndChild();
 
 	ImGui::SameLine();
@@ -1710,6 +1726,7 @@ void windows::LiveEditor::populateStrucGraph(EngineStructs::Struct* struc, Engin
 			continue;
 		}
 		visited.insert(node);
+		EngineCore::materializeStruct(node);
 
 		if (parent != nullptr)
 		{
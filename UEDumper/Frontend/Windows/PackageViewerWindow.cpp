@@ -68,6 +68,9 @@ void windows::PackageViewerWindow::renderSubTypes(const fieldType& type, bool in
 
 void windows::PackageViewerWindow::renderClassOrStruct(PackageTab* tab, EngineStructs::Struct& struc)
 {
+    //lazy structs get their members the first time they show up
+    EngineCore::materializeStruct(&struc);
+
     //copy button for clipboard
     if (ImGui::Button(std::string(std::string(ICON_FA_CLIPBOARD) + "##" + std::to_string(reinterpret_cast<__int64>(&struc.memoryAddress))).c_str()))
     {
@@ -145,7 +148,7 @@ void windows::PackageViewerWindow::renderClassOrStruct(PackageTab* tab, EngineSt
         ImGui::PopStyleColor(6);
     }
 
-    for (int i = 0; i < struc.cookedMembers.size(); i++)
+    for (size_t i = 0; i < struc.layout.size(); i++)
     {
         const auto member = struc.getMemberForIndex(i);
         if (member->missed || member->userEdited)
@@ -664,7 +667,7 @@ void windows::PackageViewerWindow::renderTabs()
                     for (int j = itemRange; j < dataVector.size() && j < itemRange + 99; j++)
                     {
                         const bool is_selected = (Tabs[currentTab].itemSelected == &dataVector[j] && Tabs[currentTab].typeSelected == type);
-                        ImGui::PushStyleColor(ImGuiCol_Text, dataVector.at(j).cookedMembers.size() > 0 ? IGHelper::Colors::white : IGHelper::Colors::grayedOut);
+                        ImGui::PushStyleColor(ImGuiCol_Text, dataVector.at(j).layout.size() > 0 ? IGHelper::Colors::white : IGHelper::Colors::grayedOut);
                         if (ImGui::Selectable(dataVector.at(j).cppName.c_str(), is_selected)) {
                             Tabs[currentTab].itemSelected = &dataVector[j];
                             Tabs[currentTab].typeSelected = type;
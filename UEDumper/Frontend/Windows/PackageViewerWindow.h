@@ -50,7 +50,7 @@ namespace windows
 				NavigationTab n;
 				for (const nlohmann::json& js : j["ti"])
 				{
-					if (const auto info = EngineCore::getInfoOfObject(js))
+					if (const auto info = EngineCore::getInfoOfObject(js.get<std::string>()))
 					{
 						n.tabIndex.push_back(std::pair(info->target, info->type));
 					}
@@ -111,12 +111,17 @@ bool windows::PackageWindow::render()
 			ImGui::Separator();
 			if (ImGui::Button("Save package"))
 			{
-				std::ofstream file(EngineSettings::getWorkingDirectory() / (packages[packagePicked].packageName + ".h"));
-				SDKGeneration::printCredits(file);
-				file << "/// Package " + packages[packagePicked].packageName << ".\n\n";
-				auto emptyMerged = std::unordered_map<std::string, std::string>{};
-				SDKGeneration::generatePackage(file, packages[packagePicked], FeatureFlags::SDK::STABLE, emptyMerged);
-				LogWindow::Log(LogWindow::logLevels::LOGLEVEL_INFO, "PACKAGE", "Saved Package %s to disk!", packages[packagePicked].packageName.c_str());
+				//the lazy members might get read first, that cant happen on the ui thread
+				std::make_unique<std::future<void>*>(new auto(std::async(std::launch::async, [picked = packagePicked] {
+					EngineCore::materializeAllStructs();
+					auto& package = EngineCore::getPackages()[picked];
+					std::ofstream file(EngineSettings::getWorkingDirectory() / (package.packageName + ".h"));
+					SDKGeneration::printCredits(file);
+					file << "/// Package " + package.packageName << ".\n\n";
+					auto emptyMerged = std::unordered_map<std::string, std::string>{};
+					SDKGeneration::generatePackage(file, package, FeatureFlags::SDK::STABLE, emptyMerged);
+					LogWindow::Log(LogWindow::logLevels::LOGLEVEL_INFO, "PACKAGE", "Saved Package %s to disk!", package.packageName.c_str());
+					}))).reset();
 			}
 			if (ImGui::Button("Copy package name"))
 			{
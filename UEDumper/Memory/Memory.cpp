@@ -116,6 +116,17 @@ void Memory::read(const void* address, void* buffer, const DWORD64 size)
 	_read(address, buffer, size);
 }
 
+void Memory::readScatter(const std::vector<ScatterEntry>& entries)
+{
+	if (entries.empty())
+		return;
+
+	totalReads += static_cast<int>(entries.size());
+	checkStatus();
+
+	_readScatter(entries.data(), entries.size());
+}
+
 void Memory::write(void* address, const void* buffer, const DWORD64 size)
 {
 	totalWrites++;
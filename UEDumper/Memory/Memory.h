@@ -52,10 +52,10 @@ private:
 	inline static MemoryStatus status = bad;
 
 	//counter for all reads done
-	inline static int totalReads = 0;
+	inline static std::atomic<int> totalReads = 0;
 
 	//counter for all writes done
-	inline static int totalWrites = 0;
+	inline static std::atomic<int> totalWrites = 0;
 
 
 
@@ -102,6 +102,24 @@ public:
 	 //read function that gets called from the templates
 	static void read(const void* address, void* buffer, DWORD64 size);
 
+	//one read of a batched read
+	struct ScatterEntry
+	{
+		//memory address to read from
+		const void* address = nullptr;
+		//memory address to write to
+		void* buffer = nullptr;
+		//size of memory to read
+		DWORD64 size = 0;
+	};
+
+	/**
+	 * \brief reads all the entries as one batch. By default this just does a read for every entry,
+	 * if your driver supports scatter reads, implement them in _readScatter in driver.h
+	 * \param entries the reads
+	 */
+	static void readScatter(const std::vector<ScatterEntry>& entries);
+
 
 	static void read(DWORD64 address, DWORD64 buffer, DWORD64 size)
 	{
@@ -73,6 +73,20 @@ inline void _read(const void* address, void* buffer, const DWORD64 size)
 }
 
 
+/**
+ * \brief batched read function. The dumper issues large batches of independent reads (e.g all the next pointers of a level),
+ * if your driver supports scatter reads (one roundtrip for many reads), replace the loop with your logic
+ * \param entries the reads (address, buffer, size)
+ * \param count number of entries
+ */
+inline void _readScatter(const Memory::ScatterEntry* entries, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        _read(entries[i].address, entries[i].buffer, entries[i].size);
+    }
+}
+
 /**
  * \brief write function (replace with your write logic)
  * \param address memory address to write to
@@ -109,6 +109,7 @@ namespace Dumpspace
 
     void Generate(int& progressDone, int& totalProgress)
     {
+        EngineCore::materializeAllStructs();
         totalProgress = EngineCore::getOffsets().size() + EngineCore::getPackages().size();
         for (const auto& offset : EngineCore::getOffsets())
         {
@@ -11,6 +11,8 @@
 #include <Frontend/IGHelper.h>
 
 #include "Frontend/Texture/TextureCreator.h"
+#include "Engine/Core/ObjectsManager.h"
+#include "Engine/Core/Core.h"
 #include "Memory/memory.h"
 #include <Settings/EngineSettings.h>
 
@@ -86,6 +88,9 @@ int main()
         ImGui::SetWindowSize(ImVec2(IGHelper::getWindowSize().x, IGHelper::getWindowSize().y));
         ImGui::SetWindowPos(ImVec2(0, 0), ImGuiCond_Once);
 
+        //the exports might still add lazy members on their threads, they wait until the frame is done
+        EngineCore::lockPackagesShared();
+
         windows::TopRowButtons::renderTopRowButtons();
 
         //either render only the live editor or the package editor
@@ -119,10 +124,15 @@ int main()
         windows::PackageViewerWindow::topmostCallback();
         windows::PackageWindow::topmostCallback();
 
+        EngineCore::unlockPackagesShared();
+
         ImGui::End();
 
         IGHelper::render();
 
+        //the windows are done with the objects they got out of the runtime cache this frame
+        ObjectsManager::releaseRuntimeObjects();
+
     }
 
     IGHelper::shutdown();
@@ -11,6 +11,8 @@
 #include <vector>
 #include <set>
 #include <future>
+#include <mutex>
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>